@@ -114,6 +114,18 @@ extern struct dirent FileEntry;
 #define _DE_ISLBL(t)    (0)
 #define _DE_ISLNK(t)    (0)
 
+#elif defined(__SIM6502__) || defined(__SIM65C02__)
+
+struct dirent {
+    char                d_name[64];
+    unsigned char       d_type;         /* 1 = file, 2 = dir, 3 = link */
+};
+
+#define _DE_ISREG(t)    ((t) == 1)
+#define _DE_ISDIR(t)    ((t) == 2)
+#define _DE_ISLBL(t)    (0)
+#define _DE_ISLNK(t)    ((t) == 3)
+
 #else
 
 struct dirent {
@@ -44,7 +44,8 @@
  *
  * $FFC0 .. $FFC9      "counter" peripheral
  * $FFCA .. $FFCB      "sim65 control" peripheral
- * $FFCC .. $FFDF      (currently unused)
+ * $FFCC .. $FFD1      "timer" peripheral
+ * $FFD2 .. $FFDF      (currently unused)
  *
  * The "peripherals" structure below corresponds to the register layout of the currently
  * defined peripherals in this memory range. Combined with the fact that the sim6502 and
@@ -79,6 +80,11 @@ extern volatile struct {
         uint8_t  cpu_mode;
         uint8_t  trace_mode;
     } sim65;
+    struct {
+        uint8_t  control;
+        uint8_t  status;
+        uint32_t period;
+    } timer;
 } peripherals;
 
 /* Values for the peripherals.counter.select field. */
@@ -107,6 +113,16 @@ extern volatile struct {
 #define SIM65_TRACE_MODE_DISABLE               0x00
 #define SIM65_TRACE_MODE_ENABLE_FULL           0x7F
 
+/* Bitfield values for the peripherals.timer.control field. */
+#define TIMER_CONTROL_ENABLE                   0x01
+#define TIMER_CONTROL_ONESHOT                  0x02
+#define TIMER_CONTROL_NMI                      0x04
+
+/* Bitfield values for the peripherals.timer.status field. Write any value to
+ * the status field to acknowledge the timer interrupt.
+ */
+#define TIMER_STATUS_EXPIRED                   0x01
+
 /* Convenience macros to enable / disable tracing at runtime. */
 #define TRACE_ON()  do peripherals.sim65.trace_mode = SIM65_TRACE_MODE_ENABLE_FULL; while(0)
 #define TRACE_OFF() do peripherals.sim65.trace_mode = SIM65_TRACE_MODE_DISABLE;     while(0)
@@ -160,6 +160,11 @@ void __fastcall__ __swap (void* p, void* q, size_t size);
 /* define old name with one underscore for backwards compatibility */
 #define _swap __swap
 #endif
+void __fastcall__ __qsort_u8 (unsigned char* base, size_t count);
+void __fastcall__ __qsort_u16 (unsigned* base, size_t count);
+/* Sort arrays of unsigned chars or unsigned ints in ascending order. These
+** are much faster than qsort() because they don't need a compare function.
+*/
 #if __CC65_STD__ == __CC65_STD_CC65__
 char* __fastcall__ itoa (int val, char* buf, int radix);
 char* __fastcall__ utoa (unsigned val, char* buf, int radix);
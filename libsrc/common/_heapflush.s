@@ -0,0 +1,15 @@
+;
+; The cc65 Authors, 2026-10-19
+;
+; Return blocks held back by an alternative allocator to the heap. The
+; default allocator doesn't hold back any blocks, so there's nothing to do.
+; Linking extra/heapclass.s replaces this module.
+;
+
+        .export         heapflush
+
+;-----------------------------------------------------------------------------
+; Code
+
+heapflush:
+        rts
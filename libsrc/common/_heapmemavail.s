@@ -8,6 +8,7 @@
 ;
 
         .importzp       ptr1, ptr2
+        .import         heapflush
         .export         ___heapmemavail
 
         .include        "_heap.inc"
@@ -19,6 +20,10 @@
 
 ___heapmemavail:
 
+; Let an alternative allocator return blocks it holds back to the heap
+
+        jsr     heapflush
+
 ; size_t Size = 0;
 
         lda     #0
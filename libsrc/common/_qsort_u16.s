@@ -0,0 +1,161 @@
+;
+; The cc65 Authors, 2026-10-19
+;
+; void __fastcall__ __qsort_u16 (unsigned* base, size_t count);
+;
+; Sort an array of unsigned ints in ascending order. The values are compared
+; inline, so there are no callbacks. The algorithm is a Shell sort, which
+; works in place and needs neither recursion nor a stack.
+;
+
+        .export         ___qsort_u16
+        .import         popax
+        .importzp       ptr1, ptr2, ptr3, sreg
+
+.rodata
+
+; The gap sequence by Ciura, extended by a factor of 2.25. The values are
+; the gaps in bytes.
+
+.define GAPS    2*1, 2*4, 2*10, 2*23, 2*57, 2*132, 2*301, 2*701, 2*1750, 2*3937, 2*8858
+
+GapLo:  .lobytes        GAPS
+GapHi:  .hibytes        GAPS
+GapCount        = * - GapHi
+
+.bss
+
+Base:   .res    2                       ; Start of the array
+End:    .res    2                       ; End of the array
+Gap:    .res    2                       ; Current gap in bytes
+GapIdx: .res    1                       ; Index of the current gap
+
+.code
+
+___qsort_u16:
+        asl     a
+        sta     End
+        txa
+        rol     a
+        sta     End+1                   ; Size of the array in bytes
+        jsr     popax                   ; Get base
+        sta     Base
+        stx     Base+1
+
+; Find the largest gap that is smaller than the size
+
+        ldx     #GapCount
+@L1:    dex
+        bpl     @L2
+        rts                             ; Less than two elements
+
+@L2:    lda     GapLo,x
+        cmp     End
+        lda     GapHi,x
+        sbc     End+1
+        bcs     @L1
+
+; Calculate the end of the array
+
+        lda     End
+        clc
+        adc     Base
+        sta     End
+        lda     End+1
+        adc     Base+1
+        sta     End+1
+
+; Do an insertion sort of the elements that are Gap apart. ptr1 is the
+; element to insert.
+
+GapLoop:
+        stx     GapIdx
+        lda     GapLo,x
+        sta     Gap
+        clc
+        adc     Base
+        sta     ptr1
+        lda     GapHi,x
+        sta     Gap+1
+        adc     Base+1
+        sta     ptr1+1
+
+NextElem:
+        lda     ptr1                    ; End of array reached?
+        cmp     End
+        lda     ptr1+1
+        sbc     End+1
+        bcs     NextGap                 ; Jump if yes
+
+        ldy     #0                      ; Get the element into sreg
+        lda     (ptr1),y
+        sta     sreg
+        iny
+        lda     (ptr1),y
+        sta     sreg+1
+        lda     ptr1                    ; ptr2 is the free slot
+        sta     ptr2
+        lda     ptr1+1
+        sta     ptr2+1
+
+; Move the preceding elements that are larger up by one gap. ptr3 is the
+; element one gap below the free slot.
+
+Shift:  lda     ptr2
+        sec
+        sbc     Gap
+        sta     ptr3
+        lda     ptr2+1
+        sbc     Gap+1
+        sta     ptr3+1
+        bcc     Insert                  ; Below address zero
+        lda     ptr3
+        cmp     Base
+        lda     ptr3+1
+        sbc     Base+1
+        bcc     Insert                  ; Jump if below the start
+
+        ldy     #1                      ; Compare with the element
+        lda     sreg+1
+        cmp     (ptr3),y
+        bcc     MoveUp                  ; Jump if element is larger
+        bne     Insert
+        dey
+        lda     sreg
+        cmp     (ptr3),y
+        bcs     Insert                  ; Jump if not larger
+
+MoveUp: ldy     #0                      ; Move it up
+        lda     (ptr3),y
+        sta     (ptr2),y
+        iny
+        lda     (ptr3),y
+        sta     (ptr2),y
+        lda     ptr3
+        sta     ptr2
+        lda     ptr3+1
+        sta     ptr2+1
+        jmp     Shift
+
+Insert: ldy     #0                      ; Store into the free slot
+        lda     sreg
+        sta     (ptr2),y
+        iny
+        lda     sreg+1
+        sta     (ptr2),y
+
+        lda     ptr1                    ; Next element
+        clc
+        adc     #2
+        sta     ptr1
+        bcc     NextElem
+        inc     ptr1+1
+        bcs     NextElem                ; Branch always
+
+NextGap:
+        ldx     GapIdx
+        dex
+        bmi     Done
+        jmp     GapLoop
+
+Done:   rts
@@ -0,0 +1,91 @@
+;
+; The cc65 Authors, 2026-10-19
+;
+; void __fastcall__ __qsort_u8 (unsigned char* base, size_t count);
+;
+; Sort an array of unsigned chars in ascending order. Since there are only
+; 256 different values, a counting sort is used: the occurrences of each
+; value are counted, then the array is refilled from the counters.
+;
+
+        .export         ___qsort_u8
+        .import         popptr1
+        .importzp       ptr1, ptr2, ptr3, tmp1
+
+.bss
+
+CountLo:        .res    256             ; Low bytes of the counters
+CountHi:        .res    256             ; High bytes of the counters
+
+.code
+
+___qsort_u8:
+        sta     ptr2
+        stx     ptr2+1                  ; Save count
+        jsr     popptr1                 ; Get base, .Y is zero
+        lda     ptr1
+        sta     ptr3
+        lda     ptr1+1
+        sta     ptr3+1                  ; Remember base
+
+; Clear the counters
+
+        tya
+        tax
+@L1:    sta     CountLo,x
+        sta     CountHi,x
+        inx
+        bne     @L1
+
+; Count the values. Do the full pages first, then the rest. .Y is zero.
+
+        ldx     ptr2+1
+        stx     tmp1                    ; Number of full pages
+        beq     @L4
+@L2:    lda     (ptr1),y
+        tax
+        inc     CountLo,x
+        bne     @L3
+        inc     CountHi,x
+@L3:    iny
+        bne     @L2
+        inc     ptr1+1
+        dec     tmp1
+        bne     @L2
+
+@L4:    cpy     ptr2                    ; Bytes in the last page
+        beq     @L6
+        lda     (ptr1),y
+        tax
+        inc     CountLo,x
+        bne     @L5
+        inc     CountHi,x
+@L5:    iny
+        bne     @L4
+
+; Refill the array from the counters. .Y is the index, .X the value.
+
+@L6:    lda     ptr3
+        sta     ptr1
+        lda     ptr3+1
+        sta     ptr1+1
+        ldy     #0
+        ldx     #0
+@L7:    lda     CountLo,x
+        ora     CountHi,x
+        beq     @L11                    ; Jump if the value doesn't occur
+@L8:    txa
+        sta     (ptr1),y
+        iny
+        bne     @L9
+        inc     ptr1+1
+@L9:    lda     CountLo,x               ; Decrement the counter
+        bne     @L10
+        dec     CountHi,x
+@L10:   dec     CountLo,x
+        bne     @L8
+        lda     CountHi,x
+        bne     @L8
+@L11:   inx
+        bne     @L7
+        rts
@@ -0,0 +1,235 @@
+;
+; The cc65 Authors, 2026-10-19
+;
+; Size class allocator. Link this module to replace malloc() and free():
+;
+;       cl65 -t sim6502 prog.c sim6502-heapclass.o
+;
+; Small blocks are rounded up to one of a few fixed sizes. Freed blocks of
+; these sizes are kept in a free list per size class, so allocating and freeing
+; them doesn't have to walk the heap free list. Larger blocks are handled by
+; the first fit allocator. When the heap is exhausted, and whenever the free
+; heap memory is queried, the blocks in the class lists are returned to the
+; heap.
+;
+; The blocks have the usual admin space, so realloc(), posix_memalign() and
+; _heapblocksize() work unchanged. While a block is in a class list, its
+; usedblock::start field is used as the link to the next block.
+;
+
+        .importzp       ptr1
+        .import         heapalloc, heapfree
+        .export         _malloc, _free, heapflush
+
+        .include        "_heap.inc"
+
+        .macpack        generic
+
+;-----------------------------------------------------------------------------
+; Constants
+
+CLASS_COUNT     = 8             ; Number of size classes
+CLASS_MAXSIZE   = 96            ; Largest block handled by a class
+
+;-----------------------------------------------------------------------------
+; Data
+
+.rodata
+
+; Size class for a block size (including the admin space). The index into
+; the table is (size - 1) / 4.
+
+ClassOf:
+        .byte   0, 0, 1, 2, 3, 3, 4, 4
+        .byte   5, 5, 5, 5, 6, 6, 6, 6
+        .byte   7, 7, 7, 7, 7, 7, 7, 7
+
+        .assert * - ClassOf = CLASS_MAXSIZE / 4, error
+
+; Block size (including the admin space) of each class
+
+ClassSize:
+        .byte   8, 12, 16, 24, 32, 48, 64, 96
+
+        .assert * - ClassSize = CLASS_COUNT, error
+
+.bss
+
+; Heads of the class free lists. Heap blocks are never located in the zero
+; page, so a high byte of zero marks an empty list.
+
+HeadLo: .res    CLASS_COUNT
+HeadHi: .res    CLASS_COUNT
+
+; Size requested from malloc(), needed for a retry
+Size:   .res    2
+
+; Class handled by heapflush
+Class:  .res    1
+
+;-----------------------------------------------------------------------------
+; void* __fastcall__ malloc (size_t size);
+
+.code
+
+_malloc:
+        sta     Size
+        stx     Size+1
+
+; Sizes of 256 and above are always handled by the first fit allocator. A
+; size of zero returns NULL (A and X are zero).
+
+        cpx     #0
+        bne     Large
+        tay
+        beq     Done
+        cmp     #CLASS_MAXSIZE-HEAP_ADMIN_SPACE+1
+        bcs     Large
+
+; Determine the class from the block size (size + HEAP_ADMIN_SPACE - 1) / 4
+
+        adc     #HEAP_ADMIN_SPACE-1     ; Carry is clear
+        lsr     a
+        lsr     a
+        tay
+        ldx     ClassOf,y
+
+; If the free list of the class isn't empty, take the first block from it
+
+        lda     HeadHi,x
+        bne     Pop
+
+; The free list is empty, allocate a block with the size of the class
+
+        lda     ClassSize,x
+        sub     #HEAP_ADMIN_SPACE
+        ldx     #0
+
+; Allocate the block from the heap. If this fails, return the blocks in the
+; class lists to the heap and try again with the original size.
+
+Large:  jsr     heapalloc
+        cpx     #0                      ; NULL?
+        bne     Done                    ; Jump if not
+        jsr     heapflush
+        lda     Size
+        ldx     Size+1
+        jmp     heapalloc
+
+Done:   rts
+
+; Remove the first block from the free list of the class in X and return the
+; user pointer. A contains the high byte of the list head.
+
+Pop:    sta     ptr1+1
+        lda     HeadLo,x
+        sta     ptr1
+
+        ldy     #usedblock::start       ; Head = block->start;
+        lda     (ptr1),y
+        sta     HeadLo,x
+        lda     ptr1                    ; block->start = block;
+        sta     (ptr1),y
+        iny
+        lda     (ptr1),y
+        sta     HeadHi,x
+        lda     ptr1+1
+        sta     (ptr1),y
+
+        tax                             ; return block + 1;
+        lda     ptr1
+        add     #HEAP_ADMIN_SPACE
+        bcc     @L1
+        inx
+@L1:    rts
+
+;-----------------------------------------------------------------------------
+; void __fastcall__ free (void* block);
+
+_free:  sta     ptr1
+        stx     ptr1+1
+        ora     ptr1+1                  ; Is the argument NULL?
+        beq     @L9                     ; Bail out if yes
+
+; Get the start of the raw block from the admin space below the user pointer.
+; Remember the user pointer on the stack in case the first fit allocator
+; has to handle the block.
+
+        txa
+        pha
+        lda     ptr1
+        pha
+        sub     #HEAP_ADMIN_SPACE
+        sta     ptr1
+        bcs     @L1
+        dec     ptr1+1
+@L1:    ldy     #usedblock::start+1
+        lda     (ptr1),y
+        tax
+        dey
+        lda     (ptr1),y
+        sta     ptr1
+        stx     ptr1+1
+
+; Only blocks that have exactly the size of a class go into a class list
+
+        ldy     #usedblock::size+1
+        lda     (ptr1),y
+        bne     @L8                     ; Jump if size >= 256
+        dey
+        lda     (ptr1),y
+        cmp     #CLASS_MAXSIZE+1
+        bcs     @L8                     ; Jump if too large for a class
+        tay                             ; Remember the size
+        sbc     #0                      ; Carry is clear, so this is size - 1
+        lsr     a
+        lsr     a
+        tax
+        lda     ClassOf,x
+        tax
+        tya
+        cmp     ClassSize,x
+        bne     @L8                     ; Jump if not the size of the class
+
+; Insert the block at the head of the list. The user pointer isn't needed.
+
+        pla
+        pla
+        ldy     #usedblock::start       ; block->start = Head;
+        lda     HeadLo,x
+        sta     (ptr1),y
+        iny
+        lda     HeadHi,x
+        sta     (ptr1),y
+        lda     ptr1                    ; Head = block;
+        sta     HeadLo,x
+        lda     ptr1+1
+        sta     HeadHi,x
+@L9:    rts
+
+; Let the first fit allocator handle the block
+
+@L8:    pla
+        tay
+        pla
+        tax
+        tya
+        jmp     heapfree
+
+;-----------------------------------------------------------------------------
+; Return the blocks in all class lists to the heap. Called by malloc() when
+; the heap is exhausted and by _heapmemavail() and _heapmaxavail().
+
+heapflush:
+        ldx     #CLASS_COUNT-1
+@L1:    lda     HeadHi,x
+        beq     @L2                     ; Jump if list is empty
+        stx     Class
+        jsr     Pop
+        jsr     heapfree
+        ldx     Class
+        jmp     @L1
+
+@L2:    dex
+        bpl     @L1
+        rts
@@ -4,8 +4,9 @@
 ; Ullrich von Bassewitz, 1.12.2000
 ;
 
-        .export         _fprintf
+        .export         _fprintf, __fprintfd
         .import         addysp, decsp4, _vfprintf
+        .import         printfdesc
         .importzp       c_sp, ptr1
 
         .macpack        generic
@@ -23,6 +24,13 @@ ParamSize:      .res    1               ; Number of parameter bytes
 .code
 
 
+; Entry for calls with a format descriptor precompiled by the compiler. .Y
+; is preserved.
+
+__fprintfd:
+        lda     #$80
+        sta     printfdesc
+
 _fprintf:
         sty     ParamSize               ; Number of param bytes passed in Y
 
@@ -3,6 +3,8 @@
 ;
 ; char* itoa (int value, char* s, int radix);
 ; char* utoa (unsigned value, char* s, int radix);
+;
+; Radix 10 and 16 are converted without division.
 ;
 
         .export         _itoa, _utoa
@@ -13,6 +15,12 @@
 .rodata
 specval:
         .byte   '-', '3', '2', '7', '6', '8', 0
+
+; Powers of ten for the decimal conversion
+pow10lo:
+        .byte   <10000, <1000, <100, <10
+pow10hi:
+        .byte   >10000, >1000, >100, >10
 .code
 
 ;
@@ -89,9 +97,17 @@ L3:     lda     sreg
 
 _utoa:  jsr     dopop           ; pop the arguments
 
+; Check for the radix values that have a faster conversion
+
+utoa:   lda     tmp1
+        cmp     #10
+        beq     todec
+        cmp     #16
+        beq     tohex
+
 ; Convert to string by dividing and push the result onto the stack
 
-utoa:   lda     #$00
+        lda     #$00
         pha                     ; sentinel
 
 ; Divide sreg/tmp1 -> sreg, remainder in a
@@ -131,6 +147,82 @@ L10:    lda     ptr3
         ldx     ptr3+1
         rts
 
+;
+; Convert to decimal by subtracting the powers of ten. tmp1 counts the digit
+; character, .Y is the index into the string.
+;
+
+todec:  ldy     #0
+        ldx     #0              ; Index of 10000
+L11:    lda     #'0'
+        sta     tmp1
+L12:    lda     sreg            ; Compare with the power of ten
+        cmp     pow10lo,x
+        lda     sreg+1
+        sbc     pow10hi,x
+        bcc     L13             ; Jump if less
+        sta     sreg+1          ; Subtract
+        lda     sreg
+        sbc     pow10lo,x
+        sta     sreg
+        inc     tmp1            ; Bump the digit
+        bne     L12             ; Branch always
+
+L13:    lda     tmp1
+        cmp     #'0'
+        bne     L14
+        cpy     #0              ; Leading zero?
+        beq     L15             ; Skip it
+L14:    sta     (ptr2),y
+        iny
+L15:    inx
+        cpx     #4
+        bne     L11
+
+        lda     sreg            ; The ones are left over
+        ora     #'0'
+        bne     L17             ; Branch always
+
+;
+; Convert to hex by splitting the bytes into nibbles
+;
+
+tohex:  ldy     #0
+        lda     sreg+1
+        jsr     hexbyte
+        lda     sreg
+        jsr     hexbyte
+        cpy     #0              ; Was the value zero?
+        bne     L18
+        lda     #'0'
+
+L17:    sta     (ptr2),y
+        iny
+L18:    lda     #0
+        sta     (ptr2),y        ; Terminate the string
+        beq     L10             ; Branch always
+
+; Output the hex digits of the byte in .A, skipping leading zeros
+
+hexbyte:
+        pha
+        lsr     a
+        lsr     a
+        lsr     a
+        lsr     a
+        jsr     hexdigit
+        pla
+        and     #$0F
+hexdigit:
+        bne     L19
+        cpy     #0              ; Leading zero?
+        beq     L20             ; Skip it
+L19:    tax
+        lda     __hextab,x
+        sta     (ptr2),y
+        iny
+L20:    rts
+
 
 
 
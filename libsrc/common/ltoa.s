@@ -3,6 +3,9 @@
 ;
 ; char* ltoa (long value, char* s, int radix);
 ; char* ultoa (unsigned long value, char* s, int radix);
+;
+; Radix 10 and 16 are converted without division. Decimal values that fit into
+; 16 bits take a shorter path, so printf doesn't need itoa for them.
 ;
 
         .export         _ltoa, _ultoa
@@ -12,6 +15,20 @@
 
         .macpack        cpu
 
+.rodata
+
+; Powers of ten for the decimal conversion, from 10^9 down to 10. Each byte
+; of the values has its own table, starting with the low bytes.
+
+pow10b0:
+        .byte   $00, $00, $80, $40, $A0, $10, $E8, $64, $0A
+pow10b1:
+        .byte   $CA, $E1, $96, $42, $86, $27, $03, $00, $00
+pow10b2:
+        .byte   $9A, $F5, $98, $0F, $01, $00, $00, $00, $00
+pow10b3:
+        .byte   $3B, $05, $00, $00, $00, $00, $00, $00, $00
+
 .code
 
 ;
@@ -90,9 +107,19 @@ L3:     lda     ptr1            ; negate val
 
 _ultoa: jsr     dopop           ; pop the arguments
 
+; Check for the radix values that have a faster conversion
+
+ultoa:  lda     tmp1
+        cmp     #10
+        bne     L21
+        jmp     todec
+L21:    cmp     #16
+        bne     L22
+        jmp     tohex
+
 ; Convert to string by dividing and push the result onto the stack
 
-ultoa:  lda     #$00
+L22:    lda     #$00
         pha                     ; sentinel
 
 ; Divide val/tmp1 -> val, remainder in a
@@ -136,6 +163,131 @@ L10:    lda     ptr3
         ldx     ptr3+1
         rts
 
+; Convert values that fit into 16 bits to decimal. Only the low bytes of the powers
+; of ten from 10^4 down have to be compared and subtracted.
+
+L23:    lda     #'0'
+        sta     tmp1
+L24:    lda     ptr1            ; Compare with the power of ten
+        cmp     pow10b0,x
+        lda     ptr1+1
+        sbc     pow10b1,x
+        bcc     L25             ; Jump if less
+        sta     ptr1+1          ; Subtract
+        lda     ptr1
+        sbc     pow10b0,x
+        sta     ptr1
+        inc     tmp1            ; Bump the digit
+        bne     L24             ; Branch always
+
+L25:    lda     tmp1
+        cmp     #'0'
+        bne     L26
+        cpy     #0              ; Leading zero?
+        beq     L27             ; Skip it
+L26:    sta     (ptr2),y
+        iny
+L27:    inx
+        cpx     #9
+        bne     L23
+        beq     L16             ; Branch always
+
+;
+; Convert to decimal by subtracting the powers of ten. tmp1 counts the digit
+; character, .Y is the index into the string.
+;
+
+todec:  ldy     #0
+        ldx     #0              ; Index of 10^9
+        lda     sreg            ; Does the value fit into 16 bits?
+        ora     sreg+1
+        bne     L11             ; Jump if not
+        ldx     #5              ; Index of 10^4
+        bne     L23             ; Branch always
+
+L11:    lda     #'0'
+        sta     tmp1
+L12:    lda     ptr1            ; Compare with the power of ten
+        cmp     pow10b0,x
+        lda     ptr1+1
+        sbc     pow10b1,x
+        lda     sreg
+        sbc     pow10b2,x
+        lda     sreg+1
+        sbc     pow10b3,x
+        bcc     L13             ; Jump if less
+        sta     sreg+1          ; Subtract
+        lda     ptr1
+        sbc     pow10b0,x
+        sta     ptr1
+        lda     ptr1+1
+        sbc     pow10b1,x
+        sta     ptr1+1
+        lda     sreg
+        sbc     pow10b2,x
+        sta     sreg
+        inc     tmp1            ; Bump the digit
+        bne     L12             ; Branch always
+
+L13:    lda     tmp1
+        cmp     #'0'
+        bne     L14
+        cpy     #0              ; Leading zero?
+        beq     L15             ; Skip it
+L14:    sta     (ptr2),y
+        iny
+L15:    inx
+        cpx     #9
+        bne     L11
+
+L16:    lda     ptr1            ; The ones are left over
+        ora     #'0'
+        bne     L17             ; Branch always
+
+;
+; Convert to hex by splitting the bytes into nibbles
+;
+
+tohex:  ldy     #0
+        lda     sreg+1
+        jsr     hexbyte
+        lda     sreg
+        jsr     hexbyte
+        lda     ptr1+1
+        jsr     hexbyte
+        lda     ptr1
+        jsr     hexbyte
+        cpy     #0              ; Was the value zero?
+        bne     L18
+        lda     #'0'
+
+L17:    sta     (ptr2),y
+        iny
+L18:    lda     #0
+        sta     (ptr2),y        ; Terminate the string
+        jmp     L10
+
+; Output the hex digits of the byte in .A, skipping leading zeros
+
+hexbyte:
+        pha
+        lsr     a
+        lsr     a
+        lsr     a
+        lsr     a
+        jsr     hexdigit
+        pla
+        and     #$0F
+hexdigit:
+        bne     L19
+        cpy     #0              ; Leading zero?
+        beq     L20             ; Skip it
+L19:    tax
+        lda     __hextab,x
+        sta     (ptr2),y
+        iny
+L20:    rts
+
 
 
 
@@ -2,12 +2,19 @@
 ; Ullrich von Bassewitz, 2003-08-20
 ; Performance increase (about 20%) by
 ; Christian Krueger, 2009-09-13
+; Self modifying page loop, separate downward tail for memcpy
+; The cc65 Authors, 2026-10-19
 ;
 ; void* __fastcall__ memcpy (void* dest, const void* src, size_t n);
 ;
-; NOTE: This function contains entry points for memmove, which will ressort
-; to memcpy for an upwards copy. Don't change this module without looking
-; at memmove!
+; NOTE: This function contains entry points for memmove and lz4, which need
+; a strict upwards copy for overlapping blocks. memcpy itself copies the last
+; partial page downwards. Don't change this module without looking at memmove!
+;
+; Whole pages are copied by a loop with absolute indexed addressing that is
+; patched with the block addresses. Since it modifies itself, it is placed in
+; the data segment. Targets that run from ROM with little RAM (NO_SMC is
+; defined for them) use indirect indexed addressing instead.
 ;
 
         .export         _memcpy, memcpy_upwards, memcpy_getparams
@@ -18,37 +25,41 @@
 _memcpy:
         jsr     memcpy_getparams
 
+        ldx     ptr3+1          ; Get high byte of n
+        beq     @L2             ; Jump if zero
+        jsr     CopyPages       ; Copy whole pages, advance ptr1/ptr2
+
+; Copy the remaining bytes downwards, which is faster. Y is zero here.
+
+@L2:    ldy     ptr3            ; Get the low byte of n
+        beq     done            ; Jump if nothing to copy
+        dey
+        beq     @L4             ; Jump if only one byte left
+@L3:    lda     (ptr1),y
+        sta     (ptr2),y
+        dey
+        bne     @L3
+@L4:    lda     (ptr1),y        ; Copy the byte at offset zero
+        sta     (ptr2),y
+        jmp     popax           ; Pop ptr and return as result
+
+; ----------------------------------------------------------------------
+; Strict upwards copy used by memmove and lz4. ptr1, ptr2 and ptr3 are set
+; up as by memcpy_getparams, dest is on the stack.
+
 memcpy_upwards:                 ; assert Y = 0
         ldx     ptr3+1          ; Get high byte of n
-        beq     L2              ; Jump if zero
+        beq     @L2             ; Jump if zero
+        jsr     CopyPages       ; Copy whole pages, advance ptr1/ptr2
 
-L1:     .repeat 2               ; Unroll this a bit to make it faster...
-        lda     (ptr1),Y        ; copy a byte
-        sta     (ptr2),Y
-        iny
-        .endrepeat
-        bne     L1
-        inc     ptr1+1
-        inc     ptr2+1
-        dex                     ; Next 256 byte block
-        bne     L1              ; Repeat if any
-
-        ; the following section could be 10% faster if we were able to copy
-        ; back to front - unfortunately we are forced to copy strict from
-        ; low to high since this function is also used for
-        ; memmove and blocks could be overlapping!
-        ; {
-L2:                             ; assert Y = 0
-        ldx     ptr3            ; Get the low byte of n
+@L2:    ldx     ptr3            ; Get the low byte of n
         beq     done            ; something to copy
 
-L3:     lda     (ptr1),Y        ; copy a byte
-        sta     (ptr2),Y
+@L3:    lda     (ptr1),y        ; copy a byte
+        sta     (ptr2),y
         iny
         dex
-        bne     L3
-
-        ; }
+        bne     @L3
 
 done:   jmp     popax           ; Pop ptr and return as result
 
@@ -77,3 +88,88 @@ memcpy_getparams:               ; IMPORTANT! Function has to leave with Y=0!
         lda     (c_sp),y        ; Get ptr2 low
         sta     ptr2
         rts
+
+; ----------------------------------------------------------------------
+; Copy X pages (X > 0) upwards from ptr1 to ptr2. On entry and exit, Y is
+; zero. On exit, the high bytes of ptr1 and ptr2 point behind the copied
+; pages.
+
+.ifndef NO_SMC
+
+CopyPages:
+        lda     ptr1            ; Patch the source addresses
+        sta     Src0+1
+        sta     Src1+1
+        sta     Src2+1
+        sta     Src3+1
+        lda     ptr1+1
+        sta     Src0+2
+        sta     Src1+2
+        sta     Src2+2
+        sta     Src3+2
+        lda     ptr2            ; Patch the destination addresses
+        sta     Dst0+1
+        sta     Dst1+1
+        sta     Dst2+1
+        sta     Dst3+1
+        lda     ptr2+1
+        sta     Dst0+2
+        sta     Dst1+2
+        sta     Dst2+2
+        sta     Dst3+2
+        txa                     ; Advance ptr1/ptr2 behind the pages
+        clc
+        adc     ptr1+1
+        sta     ptr1+1
+        txa
+        clc
+        adc     ptr2+1
+        sta     ptr2+1
+        jmp     PageLoop
+
+.data
+
+PageLoop:
+Src0:   lda     $FFFF,y         ; Patched at runtime
+Dst0:   sta     $FFFF,y         ; Patched at runtime
+        iny
+Src1:   lda     $FFFF,y
+Dst1:   sta     $FFFF,y
+        iny
+Src2:   lda     $FFFF,y
+Dst2:   sta     $FFFF,y
+        iny
+Src3:   lda     $FFFF,y
+Dst3:   sta     $FFFF,y
+        iny
+        bne     PageLoop
+        inc     Src0+2          ; Next page
+        inc     Src1+2
+        inc     Src2+2
+        inc     Src3+2
+        inc     Dst0+2
+        inc     Dst1+2
+        inc     Dst2+2
+        inc     Dst3+2
+        dex
+        bne     PageLoop
+        rts
+
+.code
+
+.else
+
+CopyPages:
+        .repeat 4               ; Unroll this a bit to make it faster...
+        lda     (ptr1),y        ; copy a byte
+        sta     (ptr2),y
+        iny
+        .endrepeat
+        bne     CopyPages
+        inc     ptr1+1
+        inc     ptr2+1
+        dex                     ; Next 256 byte block
+        bne     CopyPages       ; Repeat if any
+        rts
+
+.endif
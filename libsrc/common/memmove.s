@@ -2,10 +2,14 @@
 ; 2003-08-20, Ullrich von Bassewitz
 ; 2009-09-13, Christian Krueger -- performance increase (about 20%), 2013-07-25 improved unrolling
 ; 2015-10-23, Greg King
+; 2026-10-19, The cc65 Authors -- self modifying page loop
 ;
 ; void* __fastcall__ memmove (void* dest, const void* src, size_t size);
 ;
 ; NOTE: This function uses entry points from memcpy!
+;
+; As in memcpy, whole pages are copied by a self modifying loop in the data
+; segment, unless NO_SMC is defined for the target.
 ;
 
         .export         _memmove
@@ -57,6 +61,68 @@ PageSizeCopy:                   ; assert Y = 0
         ldx     ptr3+1          ; number of pages
         beq     done            ; none? -> done
 
+.ifndef NO_SMC
+
+; Patch the addresses of the last page into the copy loop
+
+        lda     ptr1
+        sta     Src0+1
+        sta     Src1+1
+        sta     Src2+1
+        sta     Src3+1
+        ldy     ptr1+1
+        dey
+        sty     Src0+2
+        sty     Src1+2
+        sty     Src2+2
+        sty     Src3+2
+        lda     ptr2
+        sta     Dst0+1
+        sta     Dst1+1
+        sta     Dst2+1
+        sta     Dst3+1
+        ldy     ptr2+1
+        dey
+        sty     Dst0+2
+        sty     Dst1+2
+        sty     Dst2+2
+        sty     Dst3+2
+        ldy     #0
+        jsr     PageLoop
+        jmp     popax           ; Pop ptr and return as result
+
+.data
+
+PageLoop:
+        dey                     ; 0 -> FF
+Src0:   lda     $FFFF,y         ; Patched at runtime
+Dst0:   sta     $FFFF,y         ; Patched at runtime
+        dey
+Src1:   lda     $FFFF,y         ; unrolled three times, 255/3 = 85 loops
+Dst1:   sta     $FFFF,y
+        dey
+Src2:   lda     $FFFF,y
+Dst2:   sta     $FFFF,y
+        dey
+        bne     Src0
+Src3:   lda     $FFFF,y         ; Y = 0, copy last byte
+Dst3:   sta     $FFFF,y
+        dec     Src0+2          ; Previous page
+        dec     Src1+2
+        dec     Src2+2
+        dec     Src3+2
+        dec     Dst0+2
+        dec     Dst1+2
+        dec     Dst2+2
+        dec     Dst3+2
+        dex                     ; one page to copy less
+        bne     PageLoop        ; still a page to copy?
+        rts
+
+.code
+
+.else
+
 @initBase:
         dec     ptr1+1          ; adjust base...
         dec     ptr2+1
@@ -74,6 +140,8 @@ PageSizeCopy:                   ; assert Y = 0
         dex                     ; one page to copy less
         bne     @initBase       ; still a page to copy?
 
+.endif
+
 ; Done, return dest
 
 done:   jmp     popax           ; Pop ptr and return as result
@@ -6,6 +6,8 @@
 ; Ullrich von Bassewitz, 29.05.1998
 ; Performance increase (about 20%) by
 ; Christian Krueger, 12.09.2009, slightly improved 12.01.2011
+; Self modifying page loop
+; The cc65 Authors, 2026-10-19
 ;
 ; NOTE: bzero will return it's first argument as memset does. It is no problem
 ;       to declare the return value as void, since it may be ignored. __bzero
@@ -13,6 +15,10 @@
 ;       because the compiler will replace memset by __bzero if the fill value
 ;       is zero, and the optimizer looks at the return type to see if the value
 ;       in a/x is of any use.
+;
+;       Whole pages are set by a loop with absolute indexed addressing that is
+;       patched with the block addresses, see memcpy. Targets that define
+;       NO_SMC use indirect indexed addressing instead.
 ;
 
         .export         _memset, _bzero, ___bzero
@@ -62,11 +68,50 @@ evenCount:
         sta     ptr2+1
 
         txa                     ; restore fill value
-        ldx     ptr3+1          ; Get high byte of n
+        ldy     ptr3+1          ; Get high byte of n
         beq     L2              ; Jump if zero
 
 ; Set 256/512 byte blocks
-                                ; y is still 0 here
+
+.ifndef NO_SMC
+
+        lda     ptr1            ; Patch the addresses of both sections
+        sta     Lo0+1
+        sta     Lo1+1
+        sta     Lo2+1
+        sta     Lo3+1
+        lda     ptr1+1
+        sta     Lo0+2
+        sta     Lo1+2
+        sta     Lo2+2
+        sta     Lo3+2
+        lda     ptr2
+        sta     Hi0+1
+        sta     Hi1+1
+        sta     Hi2+1
+        sta     Hi3+1
+        lda     ptr2+1
+        sta     Hi0+2
+        sta     Hi1+2
+        sta     Hi2+2
+        sta     Hi3+2
+        tya                     ; Advance ptr1/ptr2 behind the blocks
+        clc
+        adc     ptr1+1
+        sta     ptr1+1
+        tya
+        clc
+        adc     ptr2+1
+        sta     ptr2+1
+        txa                     ; restore fill value
+        ldx     ptr3+1          ; Number of blocks
+        ldy     #0
+        jsr     FillPages
+
+.else
+
+        ldx     ptr3+1          ; Number of blocks
+        ldy     #0
 L1:     .repeat 2               ; Unroll this a bit to make it faster
         sta     (ptr1),y        ; Set byte in lower section
         sta     (ptr2),y        ; Set byte in upper section
@@ -78,6 +123,8 @@ L1:     .repeat 2               ; Unroll this a bit to make it faster
         dex                     ; Next 256 byte block
         bne     L1              ; Repeat if any
 
+.endif
+
 ; Set the remaining bytes if any
 
 L2:     ldy     ptr3            ; Get the low byte of n
@@ -90,4 +137,40 @@ L3:     dey
 leave:
         jmp     popax           ; Pop ptr and return as result
 
+; Set X blocks (X > 0) of 256 bytes in both sections to the value in A.
+; Y is zero on entry and exit. The section addresses are patched in, and on
+; exit, point to the bytes behind the blocks.
+
+.ifndef NO_SMC
+
+.data
+
+FillPages:
+Lo0:    sta     $FFFF,y         ; Patched at runtime
+Hi0:    sta     $FFFF,y         ; Patched at runtime
+        iny
+Lo1:    sta     $FFFF,y
+Hi1:    sta     $FFFF,y
+        iny
+Lo2:    sta     $FFFF,y
+Hi2:    sta     $FFFF,y
+        iny
+Lo3:    sta     $FFFF,y
+Hi3:    sta     $FFFF,y
+        iny
+        bne     FillPages
+        inc     Lo0+2           ; Next block
+        inc     Lo1+2
+        inc     Lo2+2
+        inc     Lo3+2
+        inc     Hi0+2
+        inc     Hi1+2
+        inc     Hi2+2
+        inc     Hi3+2
+        dex
+        bne     FillPages
+        rts
+
+.endif
+
 
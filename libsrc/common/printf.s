@@ -4,8 +4,9 @@
 ; Ullrich von Bassewitz, 1.12.2000
 ;
 
-        .export         _printf
+        .export         _printf, __printfd
         .import         _stdout, pushax, addysp, _vfprintf
+        .import         printfdesc
         .importzp       c_sp, ptr1
 
         .macpack        generic
@@ -23,6 +24,13 @@ ParamSize:      .res    1               ; Number of parameter bytes
 .code
 
 
+; Entry for calls with a format descriptor precompiled by the compiler. .Y
+; is preserved.
+
+__printfd:
+        lda     #$80
+        sta     printfdesc
+
 _printf:
         sty     ParamSize               ; Number of param bytes passed in Y
 
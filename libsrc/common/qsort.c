@@ -3,6 +3,7 @@
 **
 ** 1998.12.09, Ullrich von Bassewitz
 ** 2015-06-21, Greg King
+** 2026-10-19, The cc65 Authors
 */
 
 
@@ -11,55 +12,101 @@
 
 
 
-static void QuickSort (register unsigned char* Base, int Lo, int Hi,
-                       register size_t Size,
-                       int __fastcall__ (* Compare) (const void*, const void*))
-/* Internal recursive function. Works with ints, but this shouldn't be
-** a problem.
+/* Partitions with up to this many elements are sorted by insertion sort */
+#define INSERTION_LIMIT 8
+
+/* Since the smaller partition is always sorted first, the stack of pending
+** partitions never has more entries than the number of bits in size_t.
 */
-{
-    int I, J;
-
-    /* Quicksort */
-    while (Hi > Lo) {
-        I = Lo + Size;
-        J = Hi;
-        while (I <= J) {
-            while (I <= J && Compare (Base + Lo, Base + I) >= 0) {
-                I += Size;
-            }
-            while (I <= J && Compare (Base + Lo, Base + J) < 0) {
-                J -= Size;
-            }
-            if (I <= J) {
-                __swap (Base + I, Base + J, Size);
-                I += Size;
-                J -= Size;
-            }
-        }
-        if (J != Lo) {
-            __swap (Base + J, Base + Lo, Size);
-        }
-        if (((unsigned) J) * 2 > (Hi + Lo)) {
-            QuickSort (Base, J + Size, Hi, Size, Compare);
-            Hi = J - Size;
-        } else {
-            QuickSort (Base, Lo, J - Size, Size, Compare);
-            Lo = J + Size;
-        }
-    }
-}
+#define STACK_SIZE      16
 
 
 
 void __fastcall__ qsort (void* base, size_t nmemb, size_t size,
                          int __fastcall__ (* compare) (const void*, const void*))
-/* Quicksort implementation */
+/* Quicksort implementation. The pivot is the median of the first, middle and
+** last element, which also serves as sentinel for the partitioning loops.
+** Small partitions are finished by insertion sort. Pending partitions are
+** kept on an explicit stack instead of recursing.
+*/
 {
-    if (nmemb > 1) {
-        QuickSort (base, 0, (nmemb-1) * size, size, compare);
+    register unsigned char* Lo;
+    register unsigned char* Hi;
+    unsigned char* I;
+    unsigned char* J;
+    unsigned char* Stack[2 * STACK_SIZE];
+    unsigned char SP = 0;
+
+    if (nmemb < 2) {
+        return;
     }
-}
 
+    Lo = base;
+    Hi = Lo + (nmemb - 1) * size;
+    while (1) {
+
+        if (Hi > Lo && (size_t) (Hi - Lo) > INSERTION_LIMIT * size) {
 
+            /* Sort the first, middle and last element, then use the median
+            ** as pivot at the start of the partition.
+            */
+            I = Lo + ((size_t) (Hi - Lo) / size / 2) * size;
+            if (compare (I, Lo) < 0) {
+                __swap (I, Lo, size);
+            }
+            if (compare (Hi, Lo) < 0) {
+                __swap (Hi, Lo, size);
+            }
+            if (compare (Hi, I) < 0) {
+                __swap (Hi, I, size);
+            }
+            __swap (Lo, I, size);
+
+            /* Partition. The last element is not smaller than the pivot,
+            ** and the pivot itself stops the downward scan.
+            */
+            I = Lo;
+            J = Hi + size;
+            while (1) {
+                do {
+                    I += size;
+                } while (compare (I, Lo) < 0);
+                do {
+                    J -= size;
+                } while (compare (Lo, J) < 0);
+                if (I >= J) {
+                    break;
+                }
+                __swap (I, J, size);
+            }
+            __swap (Lo, J, size);
+
+            /* Remember the larger partition, continue with the smaller one */
+            if ((size_t) (J - Lo) > (size_t) (Hi - J)) {
+                Stack[SP++] = Lo;
+                Stack[SP++] = J - size;
+                Lo = J + size;
+            } else {
+                Stack[SP++] = J + size;
+                Stack[SP++] = Hi;
+                Hi = J - size;
+            }
 
+        } else {
+
+            /* Insertion sort for small partitions */
+            for (I = Lo + size; I <= Hi; I += size) {
+                for (J = I; J > Lo && compare (J - size, J) > 0; J -= size) {
+                    __swap (J - size, J, size);
+                }
+            }
+
+            /* Continue with the next pending partition */
+            if (SP == 0) {
+                break;
+            }
+            Hi = Stack[--SP];
+            Lo = Stack[--SP];
+        }
+    }
+}
@@ -4,8 +4,9 @@
 ; Ullrich von Bassewitz, 2009-09-26
 ;
 
-        .export         _snprintf
+        .export         _snprintf, __snprintfd
         .import         pushax, addysp, decsp6, _vsnprintf
+        .import         printfdesc
         .importzp       c_sp, ptr1
 
         .macpack        generic
@@ -23,6 +24,18 @@ ParamSize:      .res    1               ; Number of parameter bytes
 .code
 
 
+; ----------------------------------------------------------------------------
+; Entry for calls with a format descriptor precompiled by the compiler. The
+; flag is cleared again in case an error prevented _printf from reading it.
+
+__snprintfd:
+        lda     #$80
+        sta     printfdesc
+        jsr     _snprintf
+        ldy     #0
+        sty     printfdesc
+        rts
+
 _snprintf:
         sty     ParamSize               ; Number of param bytes passed in Y
 
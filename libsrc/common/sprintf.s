@@ -4,8 +4,9 @@
 ; Ullrich von Bassewitz, 1.12.2000
 ;
 
-        .export         _sprintf
+        .export         _sprintf, __sprintfd
         .import         pushax, addysp, decsp4, _vsprintf
+        .import         printfdesc
         .importzp       c_sp, ptr1
 
         .macpack        generic
@@ -23,6 +24,18 @@ ParamSize:      .res    1               ; Number of parameter bytes
 .code
 
 
+; ----------------------------------------------------------------------------
+; Entry for calls with a format descriptor precompiled by the compiler. The
+; flag is cleared again in case an error prevented _printf from reading it.
+
+__sprintfd:
+        lda     #$80
+        sta     printfdesc
+        jsr     _sprintf
+        ldy     #0
+        sty     printfdesc
+        rts
+
 _sprintf:
         sty     ParamSize               ; Number of param bytes passed in Y
 
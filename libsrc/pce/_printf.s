@@ -7,7 +7,7 @@
 
         .include        "zeropage.inc"
 
-        .export         __printf
+        .export         __printf, printfdesc
 
         .import         popax, pushax, pusheax, decsp6, push1, axlong, axulong
         .import         _ltoa, _ultoa
@@ -215,6 +215,33 @@ OutputArg:
         jsr     pushax
         jmp     CallOutFunc
 
+; ----------------------------------------------------------------------------
+; Output the characters from FSave to the output function. FCount contains
+; the count. To make the call to out faster, build the stack frame by hand
+; (don't use pushax)
+
+OutputFSave:
+        jsr     decsp6                  ; 3 args
+        ldy     #5
+        lda     OutData+1
+        sta     (c_sp),y
+        dey
+        lda     OutData
+        sta     (c_sp),y
+        dey
+        lda     FSave+1
+        sta     (c_sp),y
+        dey
+        lda     FSave
+        sta     (c_sp),y
+        dey
+        lda     FCount+1
+        sta     (c_sp),y
+        dey
+        lda     FCount
+        sta     (c_sp),y
+        jmp     CallOutFunc             ; Call the output function
+
 ; ----------------------------------------------------------------------------
 ; ltoa: Wrapper for _ltoa that pushes all arguments
 
@@ -285,9 +312,19 @@ Save:   lda     regbank+$2000,y
         lda     (OutData),y
         sta     CallOutFunc+2
 
+; Check if the format is a precompiled descriptor (see below). The flag is
+; set by the entry points for descriptors and is valid for one call only.
+
+        lda     printfdesc
+        sta     DescMode
+        lda     #0
+        sta     printfdesc
+
 ; Start parsing the format string
 
 MainLoop:
+        bit     DescMode                ; Precompiled format?
+        bmi     DescLoop                ; Jump if yes
         lda     Format                  ; Remember current format pointer
         sta     FSave
         lda     Format+1
@@ -323,29 +360,9 @@ MainLoop:
         ora     FCount                  ; Is the result zero?
         beq     @L4                     ; Jump if yes
 
-; Output the characters that we have until now. To make the call to out
-; faster, build the stack frame by hand (don't use pushax)
+; Output the characters that we have until now
 
-        jsr     decsp6                  ; 3 args
-        ldy     #5
-        lda     OutData+1
-        sta     (c_sp),y
-        dey
-        lda     OutData
-        sta     (c_sp),y
-        dey
-        lda     FSave+1
-        sta     (c_sp),y
-        dey
-        lda     FSave
-        sta     (c_sp),y
-        dey
-        lda     FCount+1
-        sta     (c_sp),y
-        dey
-        lda     FCount
-        sta     (c_sp),y
-        jsr     CallOutFunc             ; Call the output function
+        jsr     OutputFSave
 
 ; We're back from out(), or we didn't call it. Check for end of string.
 
@@ -355,7 +372,7 @@ MainLoop:
 
 ; End of format string reached. Restore the zeropage registers and return.
 
-        ldx     #5
+Done:   ldx     #5
 Rest:   lda     RegSave,x
 
 ; The indexed-by-.X addressing mode does allow zero-page addressing.
@@ -379,6 +396,61 @@ NotDone:
 @L1:    jsr     Output1                 ; Output the character...
         jmp     MainLoop                ; ...and continue
 
+; The format is a descriptor precompiled by the compiler. It contains a
+; sequence of
+;
+;   1..127              Count of literal characters that follow
+;   $80 | flags         A conversion, followed by the width and the
+;                       conversion character. Flag bit 0 is '-', bit 1 is '0'
+;   0                   End of the descriptor
+;
+; so neither the literal characters nor the conversion have to be scanned.
+
+DescLoop:
+        jsr     GetFormatChar           ; Get next byte, zero in .Y
+        tax
+        beq     Done                    ; Jump on end of descriptor
+        bmi     DescSpec                ; Jump on conversion
+
+; A run of literal characters. Output them and skip them.
+
+        sta     FCount
+        sty     FCount+1
+        lda     Format
+        sta     FSave
+        add     FCount
+        sta     Format
+        lda     Format+1
+        sta     FSave+1
+        adc     #0
+        sta     Format+1
+        jsr     OutputFSave
+        jmp     DescLoop
+
+; A conversion. Initialize the format variables from the flags and the width,
+; then handle the conversion character as usual.
+
+DescSpec:
+        pha                             ; Save the flags
+        lda     #0
+        ldx     #FormatVarSize-1
+@L1:    sta     FormatVars,x
+        dex
+        bpl     @L1
+        pla
+        lsr     a                       ; Get '-' flag into carry
+        bcc     @L2
+        stx     LeftJust                ; .X is $FF
+@L2:    ldx     #' '                    ; PadChar
+        lsr     a                       ; Get '0' flag into carry
+        bcc     @L3
+        ldx     #'0'
+@L3:    stx     PadChar
+        jsr     GetFormatChar           ; Get the width, zero in .Y
+        sta     Width
+        lda     (Format),y              ; Get the conversion character
+        jmp     DoFormat
+
 ; We have a real format specifier
 ; Format is: %[flags][width][.precision][mod]type
 ; .Y is zero on entry.
@@ -763,6 +835,10 @@ HaveArg:
 ; Save area for the zero page registers
 RegSave:        .res    regbanksize
 
+; Set to $80 by the callers if the format is a precompiled descriptor
+printfdesc:     .byte   0
+DescMode:       .byte   0
+
 ; One character argument for OutFunc
 CharArg:        .byte   0
 
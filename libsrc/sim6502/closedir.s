@@ -0,0 +1,9 @@
+;
+; The cc65 Authors, 2026-10-19
+;
+; int __fastcall__ closedir (DIR* dir);
+;
+
+        .export         _closedir
+
+_closedir       := $FFF0
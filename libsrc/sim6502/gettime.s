@@ -0,0 +1,11 @@
+;
+; The cc65 Authors, 2026-10-19
+;
+; int __fastcall__ clock_gettime (clockid_t clk_id, struct timespec *tp);
+;
+; This is a separate module, so programs may supply their own version.
+;
+
+        .export         _clock_gettime
+
+_clock_gettime  := $FFEC
@@ -0,0 +1,48 @@
+;
+; The cc65 Authors, 2026-10-19
+;
+; IRQ handling (sim6502 version)
+;
+
+        .export         initirq, doneirq
+        .import         callirq
+
+; ------------------------------------------------------------------------
+
+.segment        "ONCE"
+
+initirq:
+        lda     #<IRQStub
+        ldx     #>IRQStub
+        sei
+        sta     $FFFE
+        stx     $FFFF
+        cli
+        rts
+
+; ------------------------------------------------------------------------
+
+.code
+
+doneirq:
+        sei
+        rts
+
+; ------------------------------------------------------------------------
+
+.segment        "LOWCODE"
+
+IRQStub:
+        cld                             ; Just to be sure
+        pha
+        txa
+        pha
+        tya
+        pha
+        jsr     callirq                 ; Call the functions
+        pla
+        tay
+        pla
+        tax
+        pla
+        rti
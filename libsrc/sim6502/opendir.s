@@ -0,0 +1,9 @@
+;
+; The cc65 Authors, 2026-10-19
+;
+; DIR* __fastcall__ opendir (const char* name);
+;
+
+        .export         _opendir
+
+_opendir        := $FFEE
@@ -10,6 +10,9 @@
         .export         exit, args, _open, _close, _read, _write, _lseek
         .export         __sysremove, ___osmaperrno
 
+                ; $FFEC-$FFF0 are used by gettime.s, stat.s, opendir.s,
+                ; readdir.s and closedir.s
+
 _lseek          := $FFF1
 __sysremove     := $FFF2
 ___osmaperrno   := $FFF3
@@ -0,0 +1,25 @@
+;
+; The cc65 Authors, 2026-10-19
+;
+; struct dirent* __fastcall__ readdir (DIR* dir);
+;
+; The paravirtualization hook fills a static entry, and returns its address
+; or NULL at the end of the directory.
+;
+
+        .export         _readdir
+        .import         pushax
+
+pvreaddir       := $FFEF
+
+.bss
+
+Entry:  .res    65                      ; struct dirent
+
+.code
+
+_readdir:
+        jsr     pushax                  ; Push dir
+        lda     #<Entry
+        ldx     #>Entry
+        jmp     pvreaddir
@@ -0,0 +1,9 @@
+;
+; The cc65 Authors, 2026-10-19
+;
+; int __fastcall__ stat (const char* pathname, struct stat* statbuf);
+;
+
+        .export         _stat
+
+_stat           := $FFED
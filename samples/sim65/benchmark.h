@@ -0,0 +1,37 @@
+/*
+ * Sim65 benchmark support.
+ *
+ * Description
+ * -----------
+ *
+ * Code shared by the sim65 benchmarks. The function 'timestamp' obtains the
+ * lower 32-bits of the clock cycle counter, as in the timer example.
+ *
+ * The function 'calibrate' takes two timestamps with nothing happening in
+ * between, and stores the difference in 'overhead'. A benchmark calls it
+ * once at the start, and subtracts 'overhead' from every measurement.
+ *
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <sim65.h>
+
+static uint32_t overhead;
+
+static uint32_t timestamp(void)
+{
+    peripherals.counter.select = COUNTER_SELECT_CLOCKCYCLE_COUNTER;
+    peripherals.counter.latch = 0;
+    return peripherals.counter.value32[0];
+}
+
+static void calibrate(void)
+/* Calibration measurement of zero clock cycles, to determine the overhead. */
+{
+    uint32_t t = timestamp();
+    overhead = timestamp() - t;
+}
+
+#endif
@@ -0,0 +1,98 @@
+/*
+ * Sim65 number conversion benchmark.
+ *
+ * Description
+ * -----------
+ *
+ * This example measures the clock cycles spent in utoa(), itoa(), ultoa()
+ * and ltoa() for decimal and hexadecimal output, and in sprintf() with a
+ * couple of numeric conversions. Each function converts a set of values
+ * with different numbers of digits, and the average is printed.
+ *
+ * Running the example
+ * -------------------
+ *
+ * cl65 -t sim6502 -O conv_benchmark.c -o conv_benchmark.prg
+ * sim65 conv_benchmark.prg
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "benchmark.h"
+
+#define COUNT (sizeof (values) / sizeof (values[0]))
+
+static const unsigned values[] = { 0, 7, 42, 999, 1234, 40000u, 65535u };
+static const unsigned long lvalues[] = {
+    0, 7, 42, 1234, 65536UL, 3000000UL, 123456789UL, 4294967295UL
+};
+
+static char buf[40];
+
+static void print_avg(const char *name, uint32_t cycles, unsigned count)
+/* Print the average cycles per conversion. */
+{
+    printf("%-24s %6lu\n", name, (cycles - overhead * count) / count);
+}
+
+int main(void)
+{
+    unsigned i;
+    uint32_t t, sum;
+
+    calibrate();
+
+    printf("%-24s %6s\n", "function", "cycles");
+
+    for (sum = 0, i = 0; i < COUNT; ++i) {
+        t = timestamp();
+        utoa(values[i], buf, 10);
+        sum += timestamp() - t;
+    }
+    print_avg("utoa (radix 10)", sum, COUNT);
+
+    for (sum = 0, i = 0; i < COUNT; ++i) {
+        t = timestamp();
+        itoa(-(int)(values[i] >> 1), buf, 10);
+        sum += timestamp() - t;
+    }
+    print_avg("itoa (radix 10)", sum, COUNT);
+
+    for (sum = 0, i = 0; i < COUNT; ++i) {
+        t = timestamp();
+        utoa(values[i], buf, 16);
+        sum += timestamp() - t;
+    }
+    print_avg("utoa (radix 16)", sum, COUNT);
+
+    for (sum = 0, i = 0; i < sizeof (lvalues) / sizeof (lvalues[0]); ++i) {
+        t = timestamp();
+        ultoa(lvalues[i], buf, 10);
+        sum += timestamp() - t;
+    }
+    print_avg("ultoa (radix 10)", sum, i);
+
+    for (sum = 0, i = 0; i < sizeof (lvalues) / sizeof (lvalues[0]); ++i) {
+        t = timestamp();
+        ltoa(-(long)(lvalues[i] >> 1), buf, 10);
+        sum += timestamp() - t;
+    }
+    print_avg("ltoa (radix 10)", sum, i);
+
+    for (sum = 0, i = 0; i < sizeof (lvalues) / sizeof (lvalues[0]); ++i) {
+        t = timestamp();
+        ultoa(lvalues[i], buf, 16);
+        sum += timestamp() - t;
+    }
+    print_avg("ultoa (radix 16)", sum, i);
+
+    for (sum = 0, i = 0; i < COUNT; ++i) {
+        t = timestamp();
+        sprintf(buf, "%u %d %x", values[i], -(int)i, values[i]);
+        sum += timestamp() - t;
+    }
+    print_avg("sprintf (\"%u %d %x\")", sum, COUNT);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+/*
+ * Sim65 heap benchmark.
+ *
+ * Description
+ * -----------
+ *
+ * This example measures the clock cycles spent in malloc() and free() under
+ * a load that resembles message processing: a pool of live blocks, most of
+ * them small, is constantly freed and replaced by blocks of random sizes.
+ * The average cycles per call are printed for both functions.
+ *
+ * Running the example
+ * -------------------
+ *
+ * cl65 -t sim6502 -O heap_benchmark.c -o heap_benchmark.prg
+ * sim65 heap_benchmark.prg
+ *
+ * To measure the size class allocator instead of the default first fit
+ * allocator, link its object file:
+ *
+ * cl65 -t sim6502 -O heap_benchmark.c sim6502-heapclass.o -o heap_benchmark.prg
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "benchmark.h"
+
+#define SLOTS   48
+#define ROUNDS  5000
+
+static void* slot[SLOTS];
+static unsigned long seed = 1;
+
+static unsigned random(void)
+{
+    seed = seed * 1103515245UL + 12345UL;
+    return (unsigned) (seed >> 16);
+}
+
+static size_t message_size(void)
+/* Mostly small messages, with an occasional large one. */
+{
+    unsigned r = random();
+    if ((r & 15) != 0) {
+        return r % 60 + 4;
+    }
+    return r % 400 + 64;
+}
+
+int main(void)
+{
+    unsigned i, k;
+    size_t size;
+    uint32_t t1, t2;
+    uint32_t alloc_cycles = 0, free_cycles = 0;
+    unsigned allocs = 0, frees = 0;
+
+    calibrate();
+
+    /* Fill the pool, then keep replacing random blocks. */
+
+    for (i = 0; i < SLOTS + ROUNDS; ++i) {
+        k = (i < SLOTS) ? i : random() % SLOTS;
+        if (slot[k] != 0) {
+            t1 = timestamp();
+            free(slot[k]);
+            t2 = timestamp();
+            free_cycles += (t2 - t1) - overhead;
+            ++frees;
+        }
+        size = message_size();
+        t1 = timestamp();
+        slot[k] = malloc(size);
+        t2 = timestamp();
+        alloc_cycles += (t2 - t1) - overhead;
+        ++allocs;
+        if (slot[k] == 0) {
+            printf("out of memory after %u allocations\n", allocs);
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("malloc: %u calls, %lu cycles per call\n", allocs, alloc_cycles / allocs);
+    printf("free:   %u calls, %lu cycles per call\n", frees, free_cycles / frees);
+
+    return EXIT_SUCCESS;
+}
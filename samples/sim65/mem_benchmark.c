@@ -0,0 +1,81 @@
+/*
+ * Sim65 memory block benchmark.
+ *
+ * Description
+ * -----------
+ *
+ * This example measures the clock cycles per byte spent in memcpy(),
+ * memmove() and memset() for a couple of block sizes. memmove() is measured
+ * in both directions, because it copies overlapping blocks upwards or
+ * downwards depending on their order. The cycles per byte are printed with
+ * two decimals.
+ *
+ * Running the example
+ * -------------------
+ *
+ * cl65 -t sim6502 -O mem_benchmark.c -o mem_benchmark.prg
+ * sim65 mem_benchmark.prg
+ *
+ * The 65C02 library is measured by building for sim65c02 instead.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "benchmark.h"
+
+#define BUFSIZE 4096
+
+static unsigned char src[BUFSIZE + 64];
+static unsigned char dst[BUFSIZE];
+
+static const size_t sizes[] = { 16, 100, 256, 1000, 4096 };
+
+static void print_rate(uint32_t cycles, size_t size)
+/* Print the cycles per byte with two decimals. */
+{
+    uint32_t rate = ((cycles - overhead) * 100UL + size / 2) / size;
+    printf(" %4lu.%02lu", rate / 100, rate % 100);
+}
+
+int main(void)
+{
+    unsigned i;
+    size_t size;
+    uint32_t t1, t2;
+
+    calibrate();
+
+    printf("bytes    memcpy  move up  move dn   memset  (cycles per byte)\n");
+    for (i = 0; i < sizeof (sizes) / sizeof (sizes[0]); ++i) {
+        size = sizes[i];
+        printf("%5u  ", size);
+
+        t1 = timestamp();
+        memcpy(dst, src, size);
+        t2 = timestamp();
+        print_rate(t2 - t1, size);
+
+        /* Overlapping blocks, memmove copies upwards */
+        t1 = timestamp();
+        memmove(src, src + 64, size);
+        t2 = timestamp();
+        print_rate(t2 - t1, size);
+
+        /* Overlapping blocks, memmove copies downwards */
+        t1 = timestamp();
+        memmove(src + 64, src, size);
+        t2 = timestamp();
+        print_rate(t2 - t1, size);
+
+        t1 = timestamp();
+        memset(dst, 0x55, size);
+        t2 = timestamp();
+        print_rate(t2 - t1, size);
+
+        printf("\n");
+    }
+
+    return EXIT_SUCCESS;
+}
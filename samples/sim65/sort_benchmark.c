@@ -0,0 +1,76 @@
+/*
+ * Sim65 sort benchmark.
+ *
+ * Description
+ * -----------
+ *
+ * This example measures the clock cycles spent in qsort() and in the
+ * specialized __qsort_u16() and __qsort_u8() for an array of 300 elements.
+ * Every function sorts random, presorted and reverse sorted data.
+ *
+ * Running the example
+ * -------------------
+ *
+ * cl65 -t sim6502 -O sort_benchmark.c -o sort_benchmark.prg
+ * sim65 sort_benchmark.prg
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "benchmark.h"
+
+#define COUNT 300
+
+static unsigned data[COUNT];
+static unsigned char bytes[COUNT];
+
+static int __fastcall__ compare(const void *a, const void *b)
+{
+    unsigned x = *(const unsigned *)a;
+    unsigned y = *(const unsigned *)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+static void fill(unsigned char kind)
+/* Fill the arrays with random (0), presorted (1) or reverse sorted data. */
+{
+    unsigned i;
+
+    srand(1);
+    for (i = 0; i < COUNT; ++i) {
+        data[i] = kind == 0 ? rand() : (kind == 1 ? i : COUNT - i);
+        bytes[i] = (unsigned char)data[i];
+    }
+}
+
+int main(void)
+{
+    static const char *const names[] = { "random", "presorted", "reversed" };
+    unsigned char kind;
+    uint32_t t1, t2, t3, t4;
+
+    calibrate();
+
+    printf("%u elements     qsort  __qsort_u16  __qsort_u8  (cycles)\n", COUNT);
+    for (kind = 0; kind < 3; ++kind) {
+        fill(kind);
+        t1 = timestamp();
+        qsort(data, COUNT, sizeof(data[0]), compare);
+        t2 = timestamp();
+
+        fill(kind);
+        t3 = timestamp();
+        __qsort_u16(data, COUNT);
+        t4 = timestamp();
+        printf("%-10s %10lu %12lu", names[kind], t2 - t1 - overhead,
+               t4 - t3 - overhead);
+
+        t1 = timestamp();
+        __qsort_u8(bytes, COUNT);
+        t2 = timestamp();
+        printf(" %11lu\n", t2 - t1 - overhead);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -56,7 +56,7 @@ void AddObjFiles(int argc, char *argv[])
    }
 
    // Open the library, read the index
-   LibOpen(argv[0], 0, 1);
+   LibOpen(argv[0], 0, LIB_OPEN_UPDATE);
 
    // Add the object files
    I = 1;
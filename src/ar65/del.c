@@ -56,7 +56,7 @@ void DelObjFiles(int argc, char *argv[])
    }
 
    // Open the library, read the index
-   LibOpen(argv[0], 1, 1);
+   LibOpen(argv[0], 1, LIB_OPEN_REWRITE);
 
    // Delete the modules
    I = 1;
@@ -56,7 +56,7 @@ void ExtractObjFiles(int argc, char *argv[])
    }
 
    // Open the library, read the index
-   LibOpen(argv[0], 1, 0);
+   LibOpen(argv[0], 1, LIB_OPEN_READ);
 
    // Extract the object files
    I = 1;
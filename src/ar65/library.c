@@ -73,6 +73,13 @@ static FILE *NewLib = 0;
 // The library header
 static LibHeader Header = {LIB_MAGIC, LIB_VERSION, 0, 0};
 
+// How the library was opened (one of the LIB_OPEN_xxx values)
+static int OpenMode = LIB_OPEN_READ;
+
+// If more than this percentage of an updated library is unused, the library
+// is compacted by writing a new copy instead of updating it in place.
+#define LIB_MAX_GARBAGE 50
+
 ////////////////////////////////////////////////////////////////////////////////
 //                       Writing file data structures
 ////////////////////////////////////////////////////////////////////////////////
@@ -89,7 +96,8 @@ static void ReadHeader(void)
       Error("'%s' is not a valid library file", LibName);
    }
    Header.Version = Read16(Lib);
-   if (Header.Version != LIB_VERSION) {
+   if (Header.Version != LIB_VERSION &&
+       Header.Version != LIB_VERSION_NOEXPORTS) {
       Error("Wrong data version in '%s'", LibName);
    }
    Header.Flags = Read16(Lib);
@@ -108,6 +116,19 @@ static void ReadIndexEntry(void)
    O->MTime = Read32(Lib);
    O->Start = Read32(Lib);
    O->Size = Read32(Lib);
+
+   // Newer libraries have the export names in the index, so there's no need
+   // to read them from the module data.
+   if (Header.Version != LIB_VERSION_NOEXPORTS) {
+      unsigned Count = ReadVar(Lib);
+      CollGrow(&O->Strings, Count);
+      CollGrow(&O->Exports, Count);
+      while (Count--) {
+         char *Name = ReadStr(Lib);
+         CollAppend(&O->Strings, Name);
+         CollAppend(&O->Exports, Name);
+      }
+   }
 }
 
 static void ReadIndex(void)
@@ -126,7 +147,11 @@ static void ReadIndex(void)
       ReadIndexEntry();
    }
 
-   // Read basic object file data from the actual entries
+   // Old libraries don't have the export names in the index. Read basic
+   // object file data from the actual entries instead.
+   if (Header.Version != LIB_VERSION_NOEXPORTS) {
+      return;
+   }
    for (I = 0; I < CollCount(&ObjPool); ++I) {
 
       // Get the object file entry
@@ -157,12 +182,20 @@ static void WriteHeader(void)
 static void WriteIndexEntry(const ObjData *O)
 // Write one index entry
 {
+   unsigned I;
+
    // Module name/flags/MTime/start/size
    WriteStr(NewLib, O->Name);
    Write16(NewLib, O->Flags & ~OBJ_HAVEDATA);
    Write32(NewLib, O->MTime);
    Write32(NewLib, O->Start);
    Write32(NewLib, O->Size);
+
+   // Export names, so the linker doesn't have to look into the module
+   WriteVar(NewLib, CollCount(&O->Exports));
+   for (I = 0; I < CollCount(&O->Exports); ++I) {
+      WriteStr(NewLib, CollConstAt(&O->Exports, I));
+   }
 }
 
 static void WriteIndex(void)
@@ -170,8 +203,9 @@ static void WriteIndex(void)
 {
    unsigned I;
 
-   // Sync I/O in case the last operation was a read
-   fseek(NewLib, 0, SEEK_CUR);
+   // The index goes to the end of the file. The seek does also sync I/O in
+   // case the last operation was a read.
+   fseek(NewLib, 0, SEEK_END);
 
    // Remember the current offset in the header
    Header.IndexOffs = ftell(NewLib);
@@ -189,16 +223,55 @@ static void WriteIndex(void)
 //                             High level stuff
 ////////////////////////////////////////////////////////////////////////////////
 
-void LibOpen(const char *Name, int MustExist, int NeedTemp)
-// Open an existing library and a temporary copy. If MustExist is true, the
-// old library is expected to exist. If NeedTemp is true, a temporary library
-// is created.
+static void OpenTemp(void)
+// Create the temporary library file
 {
-   // Remember the name
+   // Create the temporary library name
+   NewLibName = xmalloc(strlen(LibName) + (sizeof(".temp-") - 1) +
+                        2 * sizeof(unsigned int) + 1);
+   sprintf(NewLibName, "%s.temp-%X", LibName, (unsigned int)getpid());
+
+   // Create the temporary library
+   NewLib = fopen(NewLibName, "w+b");
+   if (NewLib == 0) {
+      Error("Cannot create temporary library file: %s", strerror(errno));
+   }
+
+   // Write a dummy header to the temp file
+   WriteHeader();
+}
+
+static int NeedCompaction(void)
+// Return true if an updated library contains so much unused data that it
+// should be rewritten.
+{
+   unsigned I;
+   unsigned long Used = 0;
+   unsigned long Total;
+
+   // Determine the size of all module data in use
+   for (I = 0; I < CollCount(&ObjPool); ++I) {
+      Used += ((const ObjData *)CollConstAt(&ObjPool, I))->Size;
+   }
+
+   // Everything between the header and the end of the file that isn't
+   // module data is either replaced module data or an old index.
+   fseek(NewLib, 0, SEEK_END);
+   Total = ftell(NewLib) - LIB_HDR_SIZE;
+   return (Total - Used) * 100 > Total * LIB_MAX_GARBAGE;
+}
+
+void LibOpen(const char *Name, int MustExist, int Mode)
+// Open an existing library. If MustExist is true, the old library is expected
+// to exist. Mode is one of the LIB_OPEN_xxx values and determines how the
+// library is written.
+{
+   // Remember the name and mode
    LibName = xstrdup(Name);
+   OpenMode = Mode;
 
-   // Open the existing library for reading
-   Lib = fopen(Name, "rb");
+   // Open the existing library. It is written in place when updating.
+   Lib = fopen(Name, (Mode == LIB_OPEN_UPDATE) ? "r+b" : "rb");
    if (Lib == 0) {
 
       // File does not exist
@@ -218,23 +291,36 @@ void LibOpen(const char *Name, int MustExist, int NeedTemp)
 
       // Now read the existing index
       ReadIndex();
-   }
 
-   if (NeedTemp) {
+      // A library in the old format cannot be updated in place. Convert it
+      // by writing a new copy.
+      if (OpenMode == LIB_OPEN_UPDATE &&
+          Header.Version == LIB_VERSION_NOEXPORTS) {
+         OpenMode = LIB_OPEN_REWRITE;
+      }
+      Header.Version = LIB_VERSION;
+   }
 
-      // Create the temporary library name
-      NewLibName = xmalloc(strlen(Name) + (sizeof(".temp-") - 1) +
-                           2 * sizeof(unsigned int) + 1);
-      sprintf(NewLibName, "%s.temp-%X", Name, (unsigned int)getpid());
+   if (OpenMode == LIB_OPEN_UPDATE) {
 
-      // Create the temporary library
-      NewLib = fopen(NewLibName, "w+b");
-      if (NewLib == 0) {
-         Error("Cannot create temporary library file: %s", strerror(errno));
+      // New module data is appended to the library itself. If it doesn't
+      // exist, create it.
+      if (Lib == 0) {
+         Lib = fopen(Name, "w+b");
+         if (Lib == 0) {
+            Error("Cannot create library '%s': %s", Name, strerror(errno));
+         }
+         NewLib = Lib;
+         WriteHeader();
+      }
+      else {
+         NewLib = Lib;
       }
+   }
+   else if (OpenMode == LIB_OPEN_REWRITE) {
 
-      // Write a dummy header to the temp file
-      WriteHeader();
+      // Write all data into a temporary copy
+      OpenTemp();
    }
 }
 
@@ -243,9 +329,14 @@ unsigned long LibCopyTo(FILE *F, unsigned long Bytes)
 // the temporary library file.
 {
    unsigned char Buf[4096];
+   unsigned long Pos;
+
+   // Data is always appended. The seek does also sync I/O in case the last
+   // operation on the file was a read.
+   fseek(NewLib, 0, SEEK_END);
 
    // Remember the position
-   unsigned long Pos = ftell(NewLib);
+   Pos = ftell(NewLib);
 
    // Copy loop
    while (Bytes) {
@@ -302,10 +393,35 @@ void LibClose(void)
 // Write remaining data, close both files and copy the temp file to the old
 // filename
 {
+   unsigned I;
+
+   // When updating in place, the new module data has already been appended
+   // to the library. Add a new index behind it and make the header point to
+   // it. The old index stays valid until the header is written, so an
+   // interrupted update leaves the old library intact. If too much of the
+   // file is unused, write a compacted copy instead.
+   if (OpenMode == LIB_OPEN_UPDATE) {
+      if (NeedCompaction()) {
+         Print(stdout, 1, "%s: Compacting library '%s'.\n", ProgName,
+               LibName);
+         for (I = 0; I < CollCount(&ObjPool); ++I) {
+            ((ObjData *)CollAtUnchecked(&ObjPool, I))->Flags &= ~OBJ_HAVEDATA;
+         }
+         OpenTemp();
+      }
+      else {
+         for (I = 0; I < CollCount(&ObjPool); ++I) {
+            LibCheckExports(CollAtUnchecked(&ObjPool, I));
+         }
+         WriteIndex();
+         WriteHeader();
+         NewLib = 0;
+      }
+   }
+
    // Do we have a temporary library?
    if (NewLib) {
 
-      unsigned I;
       unsigned char Buf[4096];
       size_t Count;
 
@@ -324,8 +440,7 @@ void LibClose(void)
          if ((O->Flags & OBJ_HAVEDATA) == 0) {
             // Data is still in the old library
             fseek(Lib, O->Start, SEEK_SET);
-            O->Start = ftell(NewLib);
-            LibCopyTo(Lib, O->Size);
+            O->Start = LibCopyTo(Lib, O->Size);
             O->Flags |= OBJ_HAVEDATA;
          }
       }
@@ -40,6 +40,11 @@
 //                                   Data
 ////////////////////////////////////////////////////////////////////////////////
 
+// Ways to open a library
+#define LIB_OPEN_READ 0    // Read only
+#define LIB_OPEN_REWRITE 1 // Write a new copy of the library
+#define LIB_OPEN_UPDATE 2  // Append new modules to the library in place
+
 // Name of the library file
 extern const char *LibName;
 
@@ -47,14 +52,14 @@ extern const char *LibName;
 //                                   Code
 ////////////////////////////////////////////////////////////////////////////////
 
-void LibOpen(const char *Name, int MustExist, int NeedTemp);
-// Open an existing library and a temporary copy. If MustExist is true, the
-// old library is expected to exist. If NeedTemp is true, a temporary library
-// is created.
+void LibOpen(const char *Name, int MustExist, int Mode);
+// Open an existing library. If MustExist is true, the old library is expected
+// to exist. Mode is one of the LIB_OPEN_xxx values and determines how the
+// library is written.
 
 unsigned long LibCopyTo(FILE *F, unsigned long Bytes);
-// Copy data from F to the temp library file, return the start position in
-// the temporary library file.
+// Append data from F to the library file that is written, return the start
+// position of the data.
 
 void LibCopyFrom(unsigned long Pos, unsigned long Bytes, FILE *F);
 // Copy data from the library file into another file
@@ -62,7 +62,7 @@ void ListObjFiles(int argc, char *argv[])
    }
 
    // Open the library, read the index
-   LibOpen(argv[0], 1, 0);
+   LibOpen(argv[0], 1, LIB_OPEN_READ);
 
    // List the modules
    for (I = 0; I < CollCount(&ObjPool); ++I) {
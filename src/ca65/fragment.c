@@ -37,16 +37,35 @@
 // ca65
 #include "fragment.h"
 
+////////////////////////////////////////////////////////////////////////////////
+//                                   Data
+////////////////////////////////////////////////////////////////////////////////
+
+// Fragments are never freed, so they are allocated in blocks
+#define FRAG_BLOCK_COUNT 256
+static Fragment *FragBlock = 0;
+static unsigned FragBlockFree = 0;
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                   Code
 ////////////////////////////////////////////////////////////////////////////////
 
 Fragment *NewFragment(unsigned char Type, unsigned short Len)
 // Create, initialize and return a new fragment. The fragment will be inserted
-// into the current segment.
+// into the current segment. The data pointer for literal fragments is not
+// set, this is the job of the caller.
 {
-   // Create a new fragment
-   Fragment *F = xmalloc(sizeof(*F));
+   Fragment *F;
+
+   // Get a new block of fragments if the current one is used up
+   if (FragBlockFree == 0) {
+      FragBlock = xmalloc(FRAG_BLOCK_COUNT * sizeof(Fragment));
+      FragBlockFree = FRAG_BLOCK_COUNT;
+   }
+
+   // Take the next fragment from the block
+   F = FragBlock++;
+   --FragBlockFree;
 
    // Initialize it
    F->Next = 0;
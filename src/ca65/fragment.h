@@ -53,8 +53,8 @@ struct Fragment {
    unsigned short Len; // Length for this fragment
    unsigned char Type; // Fragment type
    union {
-      unsigned char Data[sizeof(ExprNode *)]; // Literal values
-      ExprNode *Expr;                         // Expression
+      unsigned char *Data; // Literal values
+      ExprNode *Expr;      // Expression
    } V;
 };
 
@@ -64,7 +64,8 @@ struct Fragment {
 
 Fragment *NewFragment(unsigned char Type, unsigned short Len);
 // Create, initialize and return a new fragment. The fragment will be inserted
-// into the current segment.
+// into the current segment. The data pointer for literal fragments is not
+// set, this is the job of the caller.
 
 // End of fragment.h
 
@@ -356,6 +356,23 @@ void GetFullLineInfo(Collection *LineInfos)
    CollTransfer(LineInfos, &CurLineInfo);
 }
 
+int IsFullLineInfo(const Collection *LineInfos)
+// Return true if the given collection contains exactly the line infos for
+// the currently active slots, as returned by GetFullLineInfo.
+{
+   unsigned I;
+
+   if (CollCount(LineInfos) != CollCount(&CurLineInfo)) {
+      return 0;
+   }
+   for (I = 0; I < CollCount(&CurLineInfo); ++I) {
+      if (CollConstAt(LineInfos, I) != CollConstAt(&CurLineInfo, I)) {
+         return 0;
+      }
+   }
+   return 1;
+}
+
 void ReleaseFullLineInfo(Collection *LineInfos)
 // Decrease the reference count for a collection full of LineInfos, then clear
 // the collection.
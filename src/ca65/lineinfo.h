@@ -80,6 +80,10 @@ void GetFullLineInfo(Collection *LineInfos);
 // infos will be added to the given collection, existing entries will be left
 // intact. The reference count of all added entries will be increased.
 
+int IsFullLineInfo(const Collection *LineInfos);
+// Return true if the given collection contains exactly the line infos for
+// the currently active slots, as returned by GetFullLineInfo.
+
 void ReleaseFullLineInfo(Collection *LineInfos);
 // Decrease the reference count for a collection full of LineInfos, then clear
 // the collection.
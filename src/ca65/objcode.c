@@ -47,8 +47,8 @@
 void Emit0(unsigned char OPC)
 // Emit an instruction with a zero sized operand
 {
-   Fragment *F = GenFragment(FRAG_LITERAL, 1);
-   F->V.Data[0] = OPC;
+   unsigned char *D = GenLiteral(1);
+   D[0] = OPC;
 }
 
 void Emit1(unsigned char OPC, ExprNode *Value)
@@ -56,6 +56,7 @@ void Emit1(unsigned char OPC, ExprNode *Value)
 {
    long V;
    Fragment *F;
+   unsigned char *D;
 
    if (IsEasyConst(Value, &V)) {
 
@@ -64,10 +65,10 @@ void Emit1(unsigned char OPC, ExprNode *Value)
          Error("Range error (%ld not in [0..255])", V);
       }
 
-      // Create a literal fragment
-      F = GenFragment(FRAG_LITERAL, 2);
-      F->V.Data[0] = OPC;
-      F->V.Data[1] = (unsigned char)V;
+      // Create literal data
+      D = GenLiteral(2);
+      D[0] = OPC;
+      D[1] = (unsigned char)V;
       FreeExpr(Value);
    }
    else {
@@ -86,6 +87,7 @@ void Emit2(unsigned char OPC, ExprNode *Value)
 {
    long V;
    Fragment *F;
+   unsigned char *D;
 
    if (IsEasyConst(Value, &V)) {
 
@@ -94,11 +96,11 @@ void Emit2(unsigned char OPC, ExprNode *Value)
          Error("Range error (%ld not in [0..65535])", V);
       }
 
-      // Create a literal fragment
-      F = GenFragment(FRAG_LITERAL, 3);
-      F->V.Data[0] = OPC;
-      F->V.Data[1] = (unsigned char)V;
-      F->V.Data[2] = (unsigned char)(V >> 8);
+      // Create literal data
+      D = GenLiteral(3);
+      D[0] = OPC;
+      D[1] = (unsigned char)V;
+      D[2] = (unsigned char)(V >> 8);
       FreeExpr(Value);
    }
    else {
@@ -139,21 +141,17 @@ void EmitData(const void *D, unsigned Size)
    // Make a useful pointer from Data
    const unsigned char *Data = D;
 
-   // Create lots of fragments for the data
+   // Create literal data in chunks that fit into a fragment
    while (Size) {
-      Fragment *F;
 
-      // Determine the length of the next fragment
+      // Determine the length of the next chunk
       unsigned Len = Size;
-      if (Len > sizeof(F->V.Data)) {
-         Len = sizeof(F->V.Data);
+      if (Len > 0xFFFF) {
+         Len = 0xFFFF;
       }
 
-      // Create a new fragment
-      F = GenFragment(FRAG_LITERAL, Len);
-
       // Copy the data
-      memcpy(F->V.Data, Data, Len);
+      memcpy(GenLiteral(Len), Data, Len);
 
       // Next chunk
       Data += Len;
@@ -173,6 +171,7 @@ void EmitByte(ExprNode *Expr)
 {
    long V;
    Fragment *F;
+   unsigned char *D;
 
    if (IsEasyConst(Expr, &V)) {
       // Must be in byte range
@@ -180,9 +179,9 @@ void EmitByte(ExprNode *Expr)
          Error("Range error (%ld not in [0..255])", V);
       }
 
-      // Create a literal fragment
-      F = GenFragment(FRAG_LITERAL, 1);
-      F->V.Data[0] = (unsigned char)V;
+      // Create literal data
+      D = GenLiteral(1);
+      D[0] = (unsigned char)V;
       FreeExpr(Expr);
    }
    else {
@@ -197,6 +196,7 @@ void EmitWord(ExprNode *Expr)
 {
    long V;
    Fragment *F;
+   unsigned char *D;
 
    if (IsEasyConst(Expr, &V)) {
       // Must be in byte range
@@ -204,15 +204,15 @@ void EmitWord(ExprNode *Expr)
          Error("Range error (%ld not in [0..65535])", V);
       }
 
-      // Create a literal fragment
-      F = GenFragment(FRAG_LITERAL, 2);
-      F->V.Data[0] = (unsigned char)V;
-      F->V.Data[1] = (unsigned char)(V >> 8);
+      // Create literal data
+      D = GenLiteral(2);
+      D[0] = (unsigned char)V;
+      D[1] = (unsigned char)(V >> 8);
       FreeExpr(Expr);
    }
    else {
       // Emit the argument as an expression
-      Fragment *F = GenFragment(FRAG_EXPR, 2);
+      F = GenFragment(FRAG_EXPR, 2);
       F->V.Expr = Expr;
    }
 }
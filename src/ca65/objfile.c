@@ -35,10 +35,18 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <sys/types.h>
+#include <unistd.h>
+#endif
 
 // common
+#include "check.h"
 #include "fname.h"
 #include "objdefs.h"
+#include "xmalloc.h"
 
 // ca65
 #include "global.h"
@@ -49,8 +57,17 @@
 //                                   Data
 ////////////////////////////////////////////////////////////////////////////////
 
-// File descriptor
-static FILE *F = 0;
+// The object file is created in memory and written to disk in one go when
+// it is closed. ObjPos is the current write position within the buffer,
+// ObjLen the size of the data in the buffer.
+static unsigned char *ObjBuf = 0;
+static unsigned long ObjSize = 0;
+static unsigned long ObjLen = 0;
+static unsigned long ObjPos = 0;
+
+// The data is written to a temporary file which is then renamed, so the
+// output file is either complete or does not exist at all.
+static char *TmpFile = 0;
 
 // Default extension
 #define OBJ_EXT ".o"
@@ -88,7 +105,7 @@ static ObjHeader Header = {
 //                         Internally used functions
 ////////////////////////////////////////////////////////////////////////////////
 
-static void ObjWriteError(void)
+static void ObjWriteError(FILE *F)
 // Called on a write error. Will try to close and remove the file, then
 // print a fatal error.
 {
@@ -96,15 +113,31 @@ static void ObjWriteError(void)
    int Error = errno;
 
    // Force a close of the file, ignoring errors
-   fclose(F);
+   if (F) {
+      fclose(F);
+   }
 
    // Try to remove the file, also ignoring errors
-   remove(OutFile);
+   remove(TmpFile);
 
    // Now abort with a fatal error
    Fatal("Cannot write to output file '%s': %s", OutFile, strerror(Error));
 }
 
+static void ObjGrow(unsigned long Size)
+// Make sure, the buffer has room for Size more bytes at the write position
+{
+   if (ObjPos + Size > ObjSize) {
+      if (ObjSize == 0) {
+         ObjSize = 0x10000;
+      }
+      while (ObjPos + Size > ObjSize) {
+         ObjSize *= 2;
+      }
+      ObjBuf = xrealloc(ObjBuf, ObjSize);
+   }
+}
+
 static void ObjWriteHeader(void)
 // Write the object file header to the current file position
 {
@@ -149,11 +182,10 @@ void ObjOpen(void)
       OutFile = MakeFilename(InFile, OBJ_EXT);
    }
 
-   // Create the output file
-   F = fopen(OutFile, "w+b");
-   if (F == 0) {
-      Fatal("Cannot open output file '%s': %s", OutFile, strerror(errno));
-   }
+   // Create the name of the temporary file
+   TmpFile = xmalloc(strlen(OutFile) + (sizeof(".temp-") - 1) +
+                     2 * sizeof(unsigned int) + 1);
+   sprintf(TmpFile, "%s.temp-%X", OutFile, (unsigned int)getpid());
 
    // Write a dummy header
    ObjWriteHeader();
@@ -162,10 +194,10 @@ void ObjOpen(void)
 void ObjClose(void)
 // Write an update header and close the object file.
 {
+   FILE *F;
+
    // Go back to the beginning
-   if (fseek(F, 0, SEEK_SET) != 0) {
-      ObjWriteError();
-   }
+   ObjPos = 0;
 
    // If we have debug infos, set the flag in the header
    if (DbgSyms) {
@@ -175,35 +207,57 @@ void ObjClose(void)
    // Write the updated header
    ObjWriteHeader();
 
-   // Close the file
+   // Write the complete object file to the temporary file
+   F = fopen(TmpFile, "wb");
+   if (F == 0) {
+      Fatal("Cannot open output file '%s': %s", TmpFile, strerror(errno));
+   }
+   if (fwrite(ObjBuf, 1, ObjLen, F) != ObjLen) {
+      ObjWriteError(F);
+   }
    if (fclose(F) != 0) {
-      ObjWriteError();
+      ObjWriteError(0);
    }
+
+   // Replace the output file. rename() doesn't replace existing files on
+   // Windows, so remove the old one first.
+#if defined(_WIN32)
+   remove(OutFile);
+#endif
+   if (rename(TmpFile, OutFile) != 0) {
+      ObjWriteError(0);
+   }
+
+   // Free the memory
+   xfree(TmpFile);
+   TmpFile = 0;
+   xfree(ObjBuf);
+   ObjBuf = 0;
+   ObjSize = ObjLen = 0;
 }
 
 unsigned long ObjGetFilePos(void)
 // Get the current file position
 {
-   long Pos = ftell(F);
-   if (Pos < 0) {
-      ObjWriteError();
-   }
-   return Pos;
+   return ObjPos;
 }
 
 void ObjSetFilePos(unsigned long Pos)
 // Set the file position
 {
-   if (fseek(F, Pos, SEEK_SET) != 0) {
-      ObjWriteError();
-   }
+   CHECK(Pos <= ObjLen);
+   ObjPos = Pos;
 }
 
 void ObjWrite8(unsigned V)
 // Write an 8 bit value to the file
 {
-   if (putc(V, F) == EOF) {
-      ObjWriteError();
+   if (ObjPos >= ObjSize) {
+      ObjGrow(1);
+   }
+   ObjBuf[ObjPos++] = (unsigned char)V;
+   if (ObjPos > ObjLen) {
+      ObjLen = ObjPos;
    }
 }
 
@@ -273,8 +327,11 @@ void ObjWriteBuf(const StrBuf *S)
 void ObjWriteData(const void *Data, unsigned Size)
 // Write literal data to the file
 {
-   if (fwrite(Data, 1, Size, F) != Size) {
-      ObjWriteError();
+   ObjGrow(Size);
+   memcpy(ObjBuf + ObjPos, Data, Size);
+   ObjPos += Size;
+   if (ObjPos > ObjLen) {
+      ObjLen = ObjPos;
    }
 }
 
@@ -296,131 +353,131 @@ void ObjWritePos(const FilePos *Pos)
 void ObjStartOptions(void)
 // Mark the start of the option section
 {
-   Header.OptionOffs = ftell(F);
+   Header.OptionOffs = ObjPos;
 }
 
 void ObjEndOptions(void)
 // Mark the end of the option section
 {
-   Header.OptionSize = ftell(F) - Header.OptionOffs;
+   Header.OptionSize = ObjPos - Header.OptionOffs;
 }
 
 void ObjStartFiles(void)
 // Mark the start of the files section
 {
-   Header.FileOffs = ftell(F);
+   Header.FileOffs = ObjPos;
 }
 
 void ObjEndFiles(void)
 // Mark the end of the files section
 {
-   Header.FileSize = ftell(F) - Header.FileOffs;
+   Header.FileSize = ObjPos - Header.FileOffs;
 }
 
 void ObjStartSegments(void)
 // Mark the start of the segment section
 {
-   Header.SegOffs = ftell(F);
+   Header.SegOffs = ObjPos;
 }
 
 void ObjEndSegments(void)
 // Mark the end of the segment section
 {
-   Header.SegSize = ftell(F) - Header.SegOffs;
+   Header.SegSize = ObjPos - Header.SegOffs;
 }
 
 void ObjStartImports(void)
 // Mark the start of the import section
 {
-   Header.ImportOffs = ftell(F);
+   Header.ImportOffs = ObjPos;
 }
 
 void ObjEndImports(void)
 // Mark the end of the import section
 {
-   Header.ImportSize = ftell(F) - Header.ImportOffs;
+   Header.ImportSize = ObjPos - Header.ImportOffs;
 }
 
 void ObjStartExports(void)
 // Mark the start of the export section
 {
-   Header.ExportOffs = ftell(F);
+   Header.ExportOffs = ObjPos;
 }
 
 void ObjEndExports(void)
 // Mark the end of the export section
 {
-   Header.ExportSize = ftell(F) - Header.ExportOffs;
+   Header.ExportSize = ObjPos - Header.ExportOffs;
 }
 
 void ObjStartDbgSyms(void)
 // Mark the start of the debug symbol section
 {
-   Header.DbgSymOffs = ftell(F);
+   Header.DbgSymOffs = ObjPos;
 }
 
 void ObjEndDbgSyms(void)
 // Mark the end of the debug symbol section
 {
-   Header.DbgSymSize = ftell(F) - Header.DbgSymOffs;
+   Header.DbgSymSize = ObjPos - Header.DbgSymOffs;
 }
 
 void ObjStartLineInfos(void)
 // Mark the start of the line info section
 {
-   Header.LineInfoOffs = ftell(F);
+   Header.LineInfoOffs = ObjPos;
 }
 
 void ObjEndLineInfos(void)
 // Mark the end of the line info section
 {
-   Header.LineInfoSize = ftell(F) - Header.LineInfoOffs;
+   Header.LineInfoSize = ObjPos - Header.LineInfoOffs;
 }
 
 void ObjStartStrPool(void)
 // Mark the start of the string pool section
 {
-   Header.StrPoolOffs = ftell(F);
+   Header.StrPoolOffs = ObjPos;
 }
 
 void ObjEndStrPool(void)
 // Mark the end of the string pool section
 {
-   Header.StrPoolSize = ftell(F) - Header.StrPoolOffs;
+   Header.StrPoolSize = ObjPos - Header.StrPoolOffs;
 }
 
 void ObjStartAssertions(void)
 // Mark the start of the assertion table
 {
-   Header.AssertOffs = ftell(F);
+   Header.AssertOffs = ObjPos;
 }
 
 void ObjEndAssertions(void)
 // Mark the end of the assertion table
 {
-   Header.AssertSize = ftell(F) - Header.AssertOffs;
+   Header.AssertSize = ObjPos - Header.AssertOffs;
 }
 
 void ObjStartScopes(void)
 // Mark the start of the scope table
 {
-   Header.ScopeOffs = ftell(F);
+   Header.ScopeOffs = ObjPos;
 }
 
 void ObjEndScopes(void)
 // Mark the end of the scope table
 {
-   Header.ScopeSize = ftell(F) - Header.ScopeOffs;
+   Header.ScopeSize = ObjPos - Header.ScopeOffs;
 }
 
 void ObjStartSpans(void)
 // Mark the start of the span table
 {
-   Header.SpanOffs = ftell(F);
+   Header.SpanOffs = ObjPos;
 }
 
 void ObjEndSpans(void)
 // Mark the end of the span table
 {
-   Header.SpanSize = ftell(F) - Header.SpanOffs;
+   Header.SpanSize = ObjPos - Header.SpanOffs;
 }
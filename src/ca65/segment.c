@@ -81,6 +81,11 @@ Collection SegmentList = STATIC_COLLECTION_INITIALIZER;
 // Currently active segment
 Segment *ActiveSeg;
 
+// Literal data is allocated in blocks per segment, so that consecutive
+// literal fragments can be merged. Larger chunks get a block of their own.
+#define SEG_DATA_BLOCK 8192U
+#define SEG_DATA_LARGE 1024U
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                   Code
 ////////////////////////////////////////////////////////////////////////////////
@@ -103,6 +108,8 @@ static Segment *NewSegFromDef(SegDef *Def)
    S->PC = 0;
    S->AbsPC = 0;
    S->Def = Def;
+   S->DataPtr = 0;
+   S->DataFree = 0;
 
    // Insert it into the segment list
    CollAppend(&SegmentList, S);
@@ -128,12 +135,58 @@ static Segment *NewSegment(const char *Name, unsigned char AddrSize)
    return NewSegFromDef(NewSegDef(Name, AddrSize));
 }
 
+static unsigned char *SegAllocData(Segment *S, unsigned Len)
+// Allocate memory for Len bytes of literal data in segment S
+{
+   unsigned char *Data;
+
+   // Large chunks are allocated separately
+   if (Len > SEG_DATA_LARGE) {
+      return xmalloc(Len);
+   }
+
+   // Get a new block if the current one doesn't have enough room
+   if (Len > S->DataFree) {
+      S->DataPtr = xmalloc(SEG_DATA_BLOCK);
+      S->DataFree = SEG_DATA_BLOCK;
+   }
+
+   // Take the memory from the block
+   Data = S->DataPtr;
+   S->DataPtr += Len;
+   S->DataFree -= Len;
+   return Data;
+}
+
+static void IncPC(unsigned Len)
+// Increment the program counter of the active segment
+{
+   ActiveSeg->PC += Len;
+   if (OrgPerSeg) {
+      // Relocatable mode is switched per segment
+      if (!ActiveSeg->RelocMode) {
+         ActiveSeg->AbsPC += Len;
+      }
+   }
+   else {
+      // Relocatable mode is switched globally
+      if (!RelocMode) {
+         AbsPC += Len;
+      }
+   }
+}
+
 Fragment *GenFragment(unsigned char Type, unsigned short Len)
 // Generate a new fragment, add it to the current segment and return it.
 {
    // Create the new fragment
    Fragment *F = NewFragment(Type, Len);
 
+   // Literal fragments need memory for the data
+   if (Type == FRAG_LITERAL) {
+      F->V.Data = SegAllocData(ActiveSeg, Len);
+   }
+
    // Insert the fragment into the current segment
    if (ActiveSeg->Root) {
       ActiveSeg->Last->Next = F;
@@ -156,24 +209,40 @@ Fragment *GenFragment(unsigned char Type, unsigned short Len)
    }
 
    // Increment the program counter
-   ActiveSeg->PC += F->Len;
-   if (OrgPerSeg) {
-      // Relocatable mode is switched per segment
-      if (!ActiveSeg->RelocMode) {
-         ActiveSeg->AbsPC += F->Len;
-      }
-   }
-   else {
-      // Relocatable mode is switched globally
-      if (!RelocMode) {
-         AbsPC += F->Len;
-      }
-   }
+   IncPC(F->Len);
 
    // Return the fragment
    return F;
 }
 
+unsigned char *GenLiteral(unsigned short Len)
+// Add Len bytes of literal data to the current segment and return a pointer
+// to the memory for the data, which must be filled in by the caller. If
+// possible, the data is appended to the last fragment of the segment instead
+// of creating a new one.
+{
+   unsigned char *Data;
+   Fragment *F = ActiveSeg->Last;
+
+   // The data may be appended to the last fragment if it is a literal one
+   // that ends where the free memory of the segment starts, if it has the
+   // same line infos, and if it belongs to the current listing line.
+   if (F != 0 && F->Type == FRAG_LITERAL && Len <= SEG_DATA_LARGE &&
+       Len <= ActiveSeg->DataFree &&
+       F->V.Data + F->Len == ActiveSeg->DataPtr &&
+       (unsigned)F->Len + Len <= 0xFFFFU &&
+       (LineCur == 0 || LineCur->FragLast == F) && IsFullLineInfo(&F->LI)) {
+
+      Data = SegAllocData(ActiveSeg, Len);
+      F->Len += Len;
+      IncPC(Len);
+      return Data;
+   }
+
+   // Otherwise create a new fragment
+   return GenFragment(FRAG_LITERAL, Len)->V.Data;
+}
+
 void UseSeg(const SegDef *D)
 // Use the segment with the given name
 {
@@ -372,6 +441,7 @@ void SegDone(void)
                FreeExpr(F->V.Expr);
 
                // Convert the fragment into a literal fragment
+               F->V.Data = SegAllocData(S, F->Len);
                for (J = 0; J < F->Len; ++J) {
                   F->V.Data[J] = ED.Val & 0xFF;
                   ED.Val >>= 8;
@@ -61,6 +61,8 @@ struct Segment {
    unsigned long AbsPC;     // PC if in local absolute mode
                             // (OrgPerSeg is true)
    SegDef *Def;             // Segment definition (name and type)
+   unsigned char *DataPtr;  // Free memory for literal data
+   unsigned DataFree;       // Number of free bytes at DataPtr
 };
 
 // Definitions for predefined segments
@@ -84,6 +86,12 @@ extern Segment *ActiveSeg;
 Fragment *GenFragment(unsigned char Type, unsigned short Len);
 // Generate a new fragment, add it to the current segment and return it.
 
+unsigned char *GenLiteral(unsigned short Len);
+// Add Len bytes of literal data to the current segment and return a pointer
+// to the memory for the data, which must be filled in by the caller. If
+// possible, the data is appended to the last fragment of the segment instead
+// of creating a new one.
+
 void UseSeg(const SegDef *D);
 // Use the given segment
 
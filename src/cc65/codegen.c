@@ -57,6 +57,7 @@
 #include "dataseg.h"
 #include "error.h"
 #include "global.h"
+#include "profile.h"
 #include "segments.h"
 #include "stackptr.h"
 #include "stdfunc.h"
@@ -543,7 +544,7 @@ void g_swap_regvars(int StackOffs, int RegOffs, unsigned Bytes)
    AddCodeLine("ldy #$%02X", StackOffs & 0xFF);
    if (Bytes == 1) {
 
-      if (IS_Get(&CodeSizeFactor) < 165) {
+      if (GetCodeSizeFactor() < 165) {
          AddCodeLine("ldx #$%02X", RegOffs & 0xFF);
          AddCodeLine("jsr regswap1");
       }
@@ -625,7 +626,7 @@ void g_restore_regvars(int StackOffs, int RegOffs, unsigned Bytes)
       AddCodeLine("lda (c_sp),y");
       AddCodeLine("sta regbank%+d", RegOffs + 1);
    }
-   else if (Bytes == 3 && IS_Get(&CodeSizeFactor) >= 133) {
+   else if (Bytes == 3 && GetCodeSizeFactor() >= 133) {
 
       AddCodeLine("ldy #$%02X", StackOffs);
       AddCodeLine("lda (c_sp),y");
@@ -928,7 +929,7 @@ void g_leasp(int Offs)
    }
    else if (Hi == 0) {
       // 8 bit offset
-      if (IS_Get(&CodeSizeFactor) < 200) {
+      if (GetCodeSizeFactor() < 200) {
          // 8 bit offset with subroutine call
          AddCodeLine("lda #$%02X", Lo);
          AddCodeLine("jsr leaa0sp");
@@ -945,7 +946,7 @@ void g_leasp(int Offs)
          g_defcodelabel(L);
       }
    }
-   else if (IS_Get(&CodeSizeFactor) < 170) {
+   else if (GetCodeSizeFactor() < 170) {
       // Full 16 bit offset with subroutine call
       AddCodeLine("lda #$%02X", Lo);
       AddCodeLine("ldx #$%02X", Hi);
@@ -984,7 +985,7 @@ void g_leavariadic(int Offs)
    AddCodeLine("lda (c_sp),y");
 
    // Add the value of the stackpointer
-   if (IS_Get(&CodeSizeFactor) > 250) {
+   if (GetCodeSizeFactor() > 250) {
       unsigned L = GetLocalLabel();
       AddCodeLine("ldx c_sp+1");
       AddCodeLine("clc");
@@ -1082,7 +1083,7 @@ void g_putlocal(unsigned Flags, int Offs, long Val)
          }
          else {
             AddCodeLine("ldy #$%02X", Offs);
-            if ((Flags & CF_NOKEEP) == 0 || IS_Get(&CodeSizeFactor) < 160) {
+            if ((Flags & CF_NOKEEP) == 0 || GetCodeSizeFactor() < 160) {
                AddCodeLine("jsr staxysp");
             }
             else {
@@ -1329,7 +1330,7 @@ void g_reglong(unsigned from)
          if (from & CF_FORCECHAR) {
             // Conversion is from char
             if (from & CF_UNSIGNED) {
-               if (IS_Get(&CodeSizeFactor) >= 200) {
+               if (GetCodeSizeFactor() >= 200) {
                   AddCodeLine("ldx #$00");
                   AddCodeLine("stx sreg");
                   AddCodeLine("stx sreg+1");
@@ -1339,7 +1340,7 @@ void g_reglong(unsigned from)
                }
             }
             else {
-               if (IS_Get(&CodeSizeFactor) >= 366) {
+               if (GetCodeSizeFactor() >= 366) {
                   g_regint(from);
                   AddCodeLine("stx sreg");
                   AddCodeLine("stx sreg+1");
@@ -1354,7 +1355,7 @@ void g_reglong(unsigned from)
 
       case CF_INT:
          if (from & CF_UNSIGNED) {
-            if (IS_Get(&CodeSizeFactor) >= 200) {
+            if (GetCodeSizeFactor() >= 200) {
                AddCodeLine("ldy #$00");
                AddCodeLine("sty sreg");
                AddCodeLine("sty sreg+1");
@@ -1919,7 +1920,7 @@ void g_addeqlocal(unsigned flags, int Offs, unsigned long val)
       case CF_INT:
          AddCodeLine("ldy #$%02X", Offs);
          if (flags & CF_CONST) {
-            if (IS_Get(&CodeSizeFactor) >= 400) {
+            if (GetCodeSizeFactor() >= 400) {
                AddCodeLine("clc");
                AddCodeLine("lda #$%02X", (int)(val & 0xFF));
                AddCodeLine("adc (c_sp),y");
@@ -2287,7 +2288,7 @@ void g_addaddr_local(unsigned flags attribute((unused)), int offs)
 
    // Add the offset
    offs -= StackPtr;
-   if (IS_Get(&CodeSizeFactor) <= 100) {
+   if (GetCodeSizeFactor() <= 100) {
       if (offs != 0) {
          // We cannot address more then 256 bytes of locals anyway
          g_inc(CF_INT | CF_CONST, offs);
@@ -2849,7 +2850,7 @@ void g_mul(unsigned flags, unsigned long val)
 
       // Check if we can use shift instead of multiplication
       if (p2 == 0 ||
-          (p2 > 0 && IS_Get(&CodeSizeFactor) >= (Negation ? 100 : 0))) {
+          (p2 > 0 && GetCodeSizeFactor() >= (Negation ? 100 : 0))) {
 
          // Generate a shift instead
          g_asl(flags, p2);
@@ -2989,7 +2990,7 @@ void g_div(unsigned flags, unsigned long val)
          // Check if we can afford using shift instead of multiplication at the
          // cost of code size
          if (p2 == 0 ||
-             (p2 > 0 && IS_Get(&CodeSizeFactor) >= (Negation ? 200 : 170))) {
+             (p2 > 0 && GetCodeSizeFactor() >= (Negation ? 200 : 170))) {
             // Generate a conditional shift instead
             if (p2 > 0) {
                unsigned int DoShiftLabel = GetLocalLabel();
@@ -3749,7 +3750,7 @@ void g_inc(unsigned flags, unsigned long val)
             AddCodeLine("inx");
             g_defcodelabel(L);
          }
-         else if (IS_Get(&CodeSizeFactor) < 200) {
+         else if (GetCodeSizeFactor() < 200) {
             // Use jsr calls
             if (val <= 8) {
                AddCodeLine("jsr incax%lu", val);
@@ -3852,7 +3853,7 @@ void g_dec(unsigned flags, unsigned long val)
          // FALLTHROUGH
 
       case CF_INT:
-         if (IS_Get(&CodeSizeFactor) < 200) {
+         if (GetCodeSizeFactor() < 200) {
             // Use subroutines
             if (val <= 8) {
                AddCodeLine("jsr decax%d", (int)val);
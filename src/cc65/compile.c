@@ -59,6 +59,7 @@
 #include "litpool.h"
 #include "macrotab.h"
 #include "output.h"
+#include "pch.h"
 #include "pragma.h"
 #include "preproc.h"
 #include "standard.h"
@@ -497,6 +498,11 @@ void Compile(const char *FileName)
       // Close the output file
       CloseOutputFile();
    }
+   else if (SB_NotEmpty(&CreatePchName)) {
+
+      // Preprocess the header and write the precompiled header
+      CreatePrecompiledHeader();
+   }
    else {
 
       // Used for emitting externals
@@ -27,6 +27,7 @@
 #include "loadexpr.h"
 #include "macrotab.h"
 #include "preproc.h"
+#include "profile.h"
 #include "scanner.h"
 #include "seqpoint.h"
 #include "shiftexpr.h"
@@ -730,11 +731,13 @@ void DoDeferred(unsigned Flags, ExprDesc *Expr)
    Expr->Flags |= E_SIDE_EFFECTS;
 }
 
-static unsigned FunctionArgList(FuncDesc *Func, int IsFastcall, ExprDesc *ED)
+static unsigned FunctionArgList(FuncDesc *Func, int IsFastcall, ExprDesc *ED,
+                                PrintfArgs *PA)
 // Parse the argument list of the called function and pass the arguments to it.
 // Depending on several criteria, this may be done by just pushing into each
 // parameter separately, or creating the parameter frame once and then storing
-// arguments into this frame one by one.
+// arguments into this frame one by one. The arguments of printf like calls
+// are recorded in PA.
 // The function returns the size of the arguments pushed in bytes.
 {
    ExprDesc Expr;
@@ -763,7 +766,7 @@ static unsigned FunctionArgList(FuncDesc *Func, int IsFastcall, ExprDesc *ED)
    // The FrameSize variable will contain a value > 0 if storing into a frame
    // (instead of pushing) is enabled.
    //
-   if (ParamComplete && IS_Get(&CodeSizeFactor) >= 200) {
+   if (ParamComplete && GetCodeSizeFactor() >= 200) {
       // Calculate the number and size of the parameters
       FrameParams = Func->ParamCount;
       FrameSize = Func->ParamSize;
@@ -852,6 +855,9 @@ static unsigned FunctionArgList(FuncDesc *Func, int IsFastcall, ExprDesc *ED)
             TypeConversion(&Expr, StdConversion(Expr.Type));
          }
 
+         // Remember the format and the arguments of printf like calls
+         AddPrintfArg(PA, PushedCount - 1, &Expr);
+
          // Handle struct/union specially
          if (IsClassStruct(Expr.Type)) {
             // Use the replacement type
@@ -948,6 +954,7 @@ static void FunctionCall(ExprDesc *Expr)
    int IsFastcall = 0; // True if we are fast-calling the function
    int PtrOnStack = 0; // True if a pointer copy is on stack
    const Type *ReturnType;
+   PrintfArgs PA;      // Arguments of printf like calls
 
    // Skip the left paren
    NextToken();
@@ -966,6 +973,9 @@ static void FunctionCall(ExprDesc *Expr)
       IsFastcall = (Func->ParamCount > 0 || (Func->Flags & FD_EMPTY) != 0) &&
                    IsFastcallFunc(Expr->Type + 1);
 
+      // No precompiled printf formats for calls through pointers
+      InitPrintfArgs(&PA, 0, Func);
+
       // Things may be difficult, depending on where the function pointer
       // resides. If the function pointer is an expression of some sort
       // (not a local or global variable), we have to evaluate this
@@ -1009,10 +1019,14 @@ static void FunctionCall(ExprDesc *Expr)
       // If we didn't inline the function, get fastcall info
       IsFastcall = (Func->ParamCount > 0 || (Func->Flags & FD_EMPTY) != 0) &&
                    IsFastcallFunc(Expr->Type);
+
+      // Check for printf like functions that may use a precompiled format
+      InitPrintfArgs(&PA,
+                     ED_IsUneval(Expr) ? 0 : (const char *)Expr->Name, Func);
    }
 
    // Parse the argument list and pass them to the called function
-   ArgSize = FunctionArgList(Func, IsFastcall, Expr);
+   ArgSize = FunctionArgList(Func, IsFastcall, Expr, &PA);
 
    if (ArgSize > 0xFF && (Func->Flags & FD_VARIADIC) != 0) {
       Error("Total size of all arguments passed to a variadic function cannot "
@@ -1120,7 +1134,8 @@ static void FunctionCall(ExprDesc *Expr)
                 ArgSize);
       }
       else {
-         g_call(CG_CallFlags(Expr->Type), (const char *)Expr->Name, ArgSize);
+         g_call(CG_CallFlags(Expr->Type),
+                GetPrintfFuncName((const char *)Expr->Name, &PA), ArgSize);
       }
    }
 
@@ -39,6 +39,7 @@
 #include "asmcode.h"
 #include "asmlabel.h"
 #include "codegen.h"
+#include "codeseg.h"
 #include "error.h"
 #include "expr.h"
 #include "funcdesc.h"
@@ -46,6 +47,7 @@
 #include "litpool.h"
 #include "locals.h"
 #include "scanner.h"
+#include "segments.h"
 #include "stackptr.h"
 #include "standard.h"
 #include "stmt.h"
@@ -78,6 +80,7 @@ static Function *NewFunction(struct SymEntry *Sym, FuncDesc *D)
    F->TopLevelSP = 0;
    F->RegOffs = RegisterSpace;
    F->Flags = IsTypeVoid(F->ReturnType) ? FF_VOID_RETURN : FF_NONE;
+   F->Heat = PH_NONE;
 
    InitCollection(&F->LocalsBlockStack);
 
@@ -191,6 +194,20 @@ int F_HasReturn(const Function *F)
    return (F->Flags & FF_HAS_RETURN) != 0;
 }
 
+void F_AddHeat(Function *F, profheat_t Heat)
+// Account for a statement with the given profile heat
+{
+   if (Heat > F->Heat) {
+      F->Heat = Heat;
+   }
+}
+
+profheat_t F_GetHeat(const Function *F)
+// Return the highest profile heat of the statements in the function
+{
+   return F->Heat;
+}
+
 int F_IsMainFunc(const Function *F)
 // Return true if this is the main function
 {
@@ -606,6 +623,21 @@ void NewFunc(SymEntry *Func, FuncDesc *D)
       OutputLocalLiteralPool(Func->V.F.LitPool);
    }
 
+   // Let the optimizer favor speed in functions with hot code, and size in
+   // functions that were never executed in the profile run
+   if (F_GetHeat(CurrentFunc) == PH_HOT) {
+      CodeSeg *S = Func->V.F.Seg->Code;
+      if (S->CodeSizeFactor < PROFILE_HOT_CODESIZE) {
+         S->CodeSizeFactor = PROFILE_HOT_CODESIZE;
+      }
+   }
+   else if (F_GetHeat(CurrentFunc) == PH_COLD) {
+      CodeSeg *S = Func->V.F.Seg->Code;
+      if (S->CodeSizeFactor > PROFILE_COLD_CODESIZE) {
+         S->CodeSizeFactor = PROFILE_COLD_CODESIZE;
+      }
+   }
+
    // Switch back to the old segments
    PopSegContext();
 
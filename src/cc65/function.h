@@ -36,6 +36,9 @@
 
 #include "coll.h"
 
+// cc65
+#include "profile.h"
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                   Data
 ////////////////////////////////////////////////////////////////////////////////
@@ -58,6 +61,7 @@ struct Function {
    int TopLevelSP;              // SP at function top level
    unsigned RegOffs;            // Register variable space offset
    funcflags_t Flags;           // Function flags
+   profheat_t Heat;             // Highest profile heat of the statements
    Collection LocalsBlockStack; // Stack of blocks with local vars
 };
 
@@ -100,6 +104,12 @@ void F_ReturnFound(Function *F);
 int F_HasReturn(const Function *F);
 // Return true if the function contains a return statement
 
+void F_AddHeat(Function *F, profheat_t Heat);
+// Account for a statement with the given profile heat
+
+profheat_t F_GetHeat(const Function *F);
+// Return the highest profile heat of the statements in the function
+
 int F_IsMainFunc(const Function *F);
 // Return true if this is the main function
 
@@ -71,3 +71,6 @@ StrBuf FullDepName =
 StrBuf DepTarget = STATIC_STRBUF_INITIALIZER; // Name of dependency target
 StrBuf DebugTableName =
     STATIC_STRBUF_INITIALIZER; // Name of debug table dump file
+StrBuf CreatePchName =
+    STATIC_STRBUF_INITIALIZER; // Name of precompiled header to create
+StrBuf UsePchName = STATIC_STRBUF_INITIALIZER; // Name of precompiled header
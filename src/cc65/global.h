@@ -74,6 +74,8 @@ extern StrBuf DepName;        // Name of dependencies file
 extern StrBuf FullDepName;    // Name of full dependencies file
 extern StrBuf DepTarget;      // Name of dependency target
 extern StrBuf DebugTableName; // Name of debug table dump file
+extern StrBuf CreatePchName;  // Name of precompiled header to create
+extern StrBuf UsePchName;     // Name of precompiled header to use
 
 // End of global.h
 
@@ -36,6 +36,7 @@
 #include <errno.h>
 
 // common
+#include "chartype.h"
 #include "check.h"
 #include "coll.h"
 #include "debugflag.h"
@@ -53,6 +54,7 @@
 #include "input.h"
 #include "lineinfo.h"
 #include "output.h"
+#include "pch.h"
 #include "preproc.h"
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -83,6 +85,7 @@ struct AFile {
    char *PName;       // Presumed name of the file
    PPIfStack IfStack; // PP #if stack
    int MissingNL;     // Last input line was missing a newline
+   Collection *Pch;   // Input files if this is a precompiled header
 };
 
 // List of all input files
@@ -96,6 +99,10 @@ static Collection *CurrentInputStack;
 
 // Counter for the __COUNTER__ macro
 static unsigned MainFileCounter;
+
+// True if lines with tokens were read. Precompiled headers may only be used
+// before that.
+static int SeenTokens;
 LineInfo *PrevDiagnosticLI;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -149,6 +156,7 @@ static AFile *NewAFile(IFile *IF, FILE *F)
    AF->PName = 0;
    AF->IfStack.Index = -1;
    AF->MissingNL = 0;
+   AF->Pch = 0;
 
    // Increment the usage counter of the corresponding IFile. If this
    // is the first use, set the file data and output debug info if
@@ -299,6 +307,11 @@ void OpenIncludeFile(const char *Name, InputType IT)
    // We don't need N any longer, since we may now use IF->Name
    xfree(N);
 
+   // Use a precompiled header instead of the file if possible
+   if (CollCount(&AFiles) == 1 && !SeenTokens && OpenPrecompiledHeader(IF)) {
+      return;
+   }
+
    // Open the file
    F = fopen(IF->Name, "r");
    if (F == 0) {
@@ -320,6 +333,44 @@ void OpenIncludeFile(const char *Name, InputType IT)
    PreprocessBegin(IF);
 }
 
+IFile *AddPrecompiledFile(const char *Name, InputType Type, unsigned long Size,
+                          unsigned long MTime)
+// Add an input file of a precompiled header to the list of input files and
+// return it.
+{
+   IFile *IF = FindFile(Name);
+   if (IF == 0) {
+      IF = NewIFile(Name, Type);
+   }
+
+   // Set the file data and output debug info if this is the first use
+   if (IF->Usage++ == 0) {
+      IF->Size = Size;
+      IF->MTime = MTime;
+      g_fileinfo(IF->Name, IF->Size, IF->MTime);
+   }
+   return IF;
+}
+
+void OpenPrecompiledFile(IFile *IF, FILE *F, Collection *Files)
+// Read the text of a precompiled header for the include file IF from F.
+// Files are the input files of the precompiled header, which are referenced
+// by the position information in the text.
+{
+   // Allocate a new AFile structure
+   AFile *AF = NewAFile(IF, F);
+   AF->Pch = Files;
+
+   // Debugging output
+   Print(stdout, 1, "Opened precompiled header for '%s'\n", IF->Name);
+
+   // Use this file with PP
+   SetPPIfStack(&AF->IfStack);
+
+   // Begin PP for this file
+   PreprocessBegin(IF);
+}
+
 void CloseIncludeFile(void)
 // Close an include file and switch to the higher level file. Set Input to
 // NULL if this was the main file.
@@ -340,6 +391,12 @@ void CloseIncludeFile(void)
    // Close the current input file (we're just reading so no error check)
    fclose(Input->F);
 
+   // At the end of a precompiled header, the preprocessor state after the
+   // original header is restored
+   if (Input->Pch) {
+      ClosePrecompiledHeader();
+   }
+
    // If we had added an extra search path for this AFile, remove it
    if (Input->SearchPath) {
       PopSearchPath(UsrIncSearchPath);
@@ -542,6 +599,20 @@ int NextLine(void)
    // Add a termination character to the string buffer
    SB_Terminate(Line);
 
+   // In a precompiled header, a line starting with '#' contains the index of
+   // the input file and the line number of the lines that follow.
+   if (Input->Pch && SB_LookAt(Line, 0) == '#') {
+      unsigned Index;
+      unsigned LineNum;
+      if (sscanf(SB_GetConstBuf(Line) + 1, "%u %u", &Index, &LineNum) != 2 ||
+          Index >= CollCount(Input->Pch) || LineNum == 0) {
+         Fatal("Invalid precompiled header");
+      }
+      Input->Input = CollAt(Input->Pch, Index);
+      Input->LineNum = LineNum - 1;
+      return NextLine();
+   }
+
    // Initialize the current and next characters.
    InitLine(Line);
 
@@ -568,8 +639,23 @@ int PreprocessNextLine(void)
       CloseIncludeFile();
    }
 
-   // Do preprocess anyways
-   Preprocess();
+   // Do preprocess anyways. The text of a precompiled header was
+   // preprocessed when it was created, so its macros must not be expanded
+   // again.
+   if (((const AFile *)CollLast(&AFiles))->Pch == 0) {
+      Preprocess();
+   }
+
+   // Remember if there were any tokens
+   if (!SeenTokens) {
+      unsigned I;
+      for (I = 0; I < SB_GetLen(Line); ++I) {
+         if (!IsSpace(SB_AtUnchecked(Line, I))) {
+            SeenTokens = 1;
+            break;
+         }
+      }
+   }
 
    // Write it to the output file if in preprocess-only mode
    if (PreprocessOnly) {
@@ -766,6 +852,29 @@ unsigned GetCurrentCounter(void)
    return MainFileCounter++;
 }
 
+const IFile *GetCurrentInputFile(unsigned *LineNum)
+// Return the current input file and the actual line number in it
+{
+   const AFile *AF;
+
+   CHECK(CollCount(&AFiles) > 0);
+   AF = CollLast(&AFiles);
+   *LineNum = AF->LineNum;
+   return AF->Input;
+}
+
+unsigned GetInputFileCount(void)
+// Return the number of input files
+{
+   return CollCount(&IFiles);
+}
+
+const IFile *GetInputFile(unsigned Index)
+// Return the input file with the given index
+{
+   return CollConstAt(&IFiles, Index);
+}
+
 static void WriteEscaped(FILE *F, const char *Name)
 // Write a file name to a dependency file escaping spaces
 {
@@ -99,6 +99,16 @@ void CloseIncludeFile(void);
 // Close an include file and switch to the higher level file. Set Input to
 // NULL if this was the main file.
 
+IFile *AddPrecompiledFile(const char *Name, InputType Type, unsigned long Size,
+                          unsigned long MTime);
+// Add an input file of a precompiled header to the list of input files and
+// return it.
+
+void OpenPrecompiledFile(IFile *IF, FILE *F, Collection *Files);
+// Read the text of a precompiled header for the include file IF from F.
+// Files are the input files of the precompiled header, which are referenced
+// by the position information in the text.
+
 void NextChar(void);
 // Read the next character from the input stream and make CurC and NextC
 // valid. If end of line is reached, both are set to NUL, no more lines
@@ -156,6 +166,15 @@ void SetCurrentFileName(const char *Name);
 unsigned GetCurrentCounter(void);
 // Return the counter number in the current input file
 
+const IFile *GetCurrentInputFile(unsigned *LineNum);
+// Return the current input file and the actual line number in it
+
+unsigned GetInputFileCount(void);
+// Return the number of input files
+
+const IFile *GetInputFile(unsigned Index);
+// Return the input file with the given index
+
 void CreateDependencies(void);
 // Create dependency files requested by the user
 
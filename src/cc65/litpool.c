@@ -177,6 +177,12 @@ unsigned GetLiteralSize(const Literal *L)
    return SB_GetLen(&L->Data);
 }
 
+void SetLiteralStrBuf(Literal *L, const StrBuf *S)
+// Replace the data of a literal
+{
+   SB_Copy(&L->Data, S);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                   Code
 ////////////////////////////////////////////////////////////////////////////////
@@ -80,6 +80,9 @@ const StrBuf *GetLiteralStrBuf(const Literal *L);
 unsigned GetLiteralSize(const Literal *L);
 // Get the size of a literal string
 
+void SetLiteralStrBuf(Literal *L, const StrBuf *S);
+// Replace the data of a literal
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                   Code
 ////////////////////////////////////////////////////////////////////////////////
@@ -290,6 +290,19 @@ Macro *FindMacro(const char *Name)
    return 0;
 }
 
+void CollectMacros(Collection *C)
+// Append all macros in the macro table to the given collection
+{
+   unsigned I;
+   for (I = 0; I < MACRO_TAB_SIZE; ++I) {
+      Macro *M = MacroTab[I];
+      while (M) {
+         CollAppend(C, M);
+         M = M->Next;
+      }
+   }
+}
+
 int FindMacroParam(const Macro *M, const char *Param)
 // Search for a macro parameter. If found, return the index of the parameter.
 // If the parameter was not found, return -1.
@@ -103,6 +103,9 @@ INLINE int IsMacro(const char *Name)
 #define IsMacro(Name) (FindMacro(Name) != 0)
 #endif
 
+void CollectMacros(Collection *C);
+// Append all macros in the macro table to the given collection
+
 int FindMacroParam(const Macro *M, const char *Param);
 // Search for a macro parameter. If found, return the index of the parameter.
 // If the parameter was not found, return -1.
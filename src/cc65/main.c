@@ -62,6 +62,7 @@
 #include "input.h"
 #include "macrotab.h"
 #include "output.h"
+#include "profile.h"
 #include "scanner.h"
 #include "segments.h"
 #include "standard.h"
@@ -109,6 +110,7 @@ static void Usage(void)
           "  --cpu type\t\t\tSet cpu type (6502, 65c02)\n"
           "  --create-dep name\t\tCreate a make dependency file\n"
           "  --create-full-dep name\tCreate a full make dependency file\n"
+          "  --create-pch name\t\tCreate a precompiled header\n"
           "  --data-name seg\t\tSet the name of the DATA segment\n"
           "  --debug\t\t\tDebug mode\n"
           "  --debug-tables name\t\tWrite symbol table debug info to a file\n"
@@ -126,6 +128,7 @@ static void Usage(void)
           "  --list-warnings\t\tList available warning types for -W\n"
           "  --local-strings\t\tEmit string literals immediately\n"
           "  --memory-model model\t\tSet the memory model\n"
+          "  --profile-use file\t\tOptimize using an execution profile\n"
           "  --register-space b\t\tSet space available for register variables\n"
           "  --register-vars\t\tEnable register variables\n"
           "  --rodata-name seg\t\tSet the name of the RODATA segment\n"
@@ -133,6 +136,7 @@ static void Usage(void)
           "  --standard std\t\tLanguage standard (c89, c99, cc65)\n"
           "  --static-locals\t\tMake local variables static\n"
           "  --target sys\t\t\tSet the target system\n"
+          "  --use-pch name\t\tUse a precompiled header\n"
           "  --verbose\t\t\tIncrease verbosity\n"
           "  --version\t\t\tPrint the compiler version number\n"
           "  --writable-strings\t\tMake string literals writable\n",
@@ -543,6 +547,12 @@ static void OptCreateFullDep(const char *Opt attribute((unused)),
    FileNameOption(Opt, Arg, &FullDepName);
 }
 
+static void OptCreatePch(const char *Opt, const char *Arg)
+// Handle the --create-pch option
+{
+   FileNameOption(Opt, Arg, &CreatePchName);
+}
+
 static void OptCPU(const char *Opt, const char *Arg)
 // Handle the --cpu option
 {
@@ -752,6 +762,12 @@ static void OptMemoryModel(const char *Opt, const char *Arg)
    SetMemoryModel(M);
 }
 
+static void OptProfileUse(const char *Opt attribute((unused)), const char *Arg)
+// Read an execution profile for profile guided optimization
+{
+   ReadProfile(Arg);
+}
+
 static void OptRegisterSpace(const char *Opt, const char *Arg)
 // Handle the --register-space option
 {
@@ -814,6 +830,12 @@ static void OptTarget(const char *Opt attribute((unused)), const char *Arg)
    SetSys(Arg);
 }
 
+static void OptUsePch(const char *Opt, const char *Arg)
+// Handle the --use-pch option
+{
+   FileNameOption(Opt, Arg, &UsePchName);
+}
+
 static void OptVerbose(const char *Opt attribute((unused)),
                        const char *Arg attribute((unused)))
 // Increase verbosity
@@ -894,6 +916,7 @@ int main(int argc, char *argv[]) {
        {"--cpu", 1, OptCPU},
        {"--create-dep", 1, OptCreateDep},
        {"--create-full-dep", 1, OptCreateFullDep},
+       {"--create-pch", 1, OptCreatePch},
        {"--data-name", 1, OptDataName},
        {"--debug", 0, OptDebug},
        {"--debug-tables", 1, OptDebugTables},
@@ -911,6 +934,7 @@ int main(int argc, char *argv[]) {
        {"--list-warnings", 0, OptListWarnings},
        {"--local-strings", 0, OptLocalStrings},
        {"--memory-model", 1, OptMemoryModel},
+       {"--profile-use", 1, OptProfileUse},
        {"--register-space", 1, OptRegisterSpace},
        {"--register-vars", 0, OptRegisterVars},
        {"--rodata-name", 1, OptRodataName},
@@ -918,6 +942,7 @@ int main(int argc, char *argv[]) {
        {"--standard", 1, OptStandard},
        {"--static-locals", 0, OptStaticLocals},
        {"--target", 1, OptTarget},
+       {"--use-pch", 1, OptUsePch},
        {"--verbose", 0, OptVerbose},
        {"--version", 0, OptVersion},
        {"--writable-strings", 0, OptWritableStrings},
@@ -1097,6 +1122,11 @@ int main(int argc, char *argv[]) {
       AbEnd("Preprocessor macro output can only be used together with -E");
    }
 
+   // A precompiled header cannot be created when preprocessing only
+   if (SB_NotEmpty(&CreatePchName) && PreprocessOnly) {
+      AbEnd("-E cannot be used together with --create-pch");
+   }
+
    // Add the default include search paths.
    FinishIncludePaths();
 
@@ -1131,8 +1161,10 @@ int main(int argc, char *argv[]) {
    // Go!
    Compile(InputFile);
 
-   // Create the output file if we didn't had any errors
-   if (PreprocessOnly == 0 && (GetTotalErrors() == 0 || Debug)) {
+   // Create the output file if we didn't had any errors. There is no output
+   // file if a precompiled header was created.
+   if (PreprocessOnly == 0 && SB_IsEmpty(&CreatePchName) &&
+       (GetTotalErrors() == 0 || Debug)) {
 
       // Emit literals, do cleanup and optimizations
       FinishCompile();
@@ -0,0 +1,606 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//                                   pch.c
+//
+//                           Precompiled headers
+//
+//
+//
+// (C) 2026, The cc65 Authors
+//
+//
+// This software is provided 'as-is', without any expressed or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+// A precompiled header is a text file that starts with a version line. It
+// contains the input files of the header, the macros defined before and after
+// the header, and the preprocessed text of the header:
+//
+//    cc65 pch <format> <compiler version>
+//    H <full path of the header>
+//    F <type> <size> <mtime> <guard macro or -> <name>
+//    I <predefined> <variadic> <param count> <name> <params>
+//    <replacement>
+//    M <predefined> <variadic> <param count> <name> <params>
+//    <replacement>
+//    T
+//    <text>
+//
+// Lines starting with '#' in the text contain the index of the input file and
+// the line number of the lines that follow. Empty lines are left out. The
+// first input file is the header itself.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+// common
+#include "chartype.h"
+#include "coll.h"
+#include "filestat.h"
+#include "print.h"
+#include "strbuf.h"
+#include "version.h"
+#include "xmalloc.h"
+#include "xsprintf.h"
+
+// cc65
+#include "error.h"
+#include "global.h"
+#include "input.h"
+#include "macrotab.h"
+#include "pch.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//                                   Data
+////////////////////////////////////////////////////////////////////////////////
+
+// Version of the file format
+#define PCH_FORMAT 2
+
+// An input file as stored in a precompiled header
+typedef struct PchFile PchFile;
+struct PchFile {
+   InputType Type;      // Type of input file
+   unsigned long Size;  // File size
+   unsigned long MTime; // Time of last modification
+   char *Guard;         // Include guard macro or NULL
+   char *Name;          // Name of the file
+};
+
+// Full path of the header of the precompiled header in use
+static char *PchHeader = 0;
+
+// Input files of the precompiled header in use, as stored and as IFiles
+static Collection PchFiles = STATIC_COLLECTION_INITIALIZER;
+static Collection InputFiles = STATIC_COLLECTION_INITIALIZER;
+
+// Macros after the header
+static Collection PchMacros = STATIC_COLLECTION_INITIALIZER;
+
+// True if the use of a precompiled header was tried
+static int Tried = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+//                              Helper functions
+////////////////////////////////////////////////////////////////////////////////
+
+static int IsVolatileMacro(const char *Name)
+// Return true if the value of a macro depends on the time or on the source
+// position. These macros are neither stored nor restored.
+{
+   static const char *const Names[] = {
+       "__COUNTER__", "__DATE__", "__FILE__", "__LINE__", "__TIME__",
+   };
+   unsigned I;
+
+   for (I = 0; I < sizeof(Names) / sizeof(Names[0]); ++I) {
+      if (strcmp(Name, Names[I]) == 0) {
+         return 1;
+      }
+   }
+   return 0;
+}
+
+static char *GetFullPath(const char *Name)
+// Return the full path of a file with all symbolic links resolved. If it
+// cannot be determined, a copy of the name is returned. The result must be
+// freed with xfree.
+{
+#if defined(_WIN32)
+   char *Path = _fullpath(0, Name, 0);
+#else
+   char *Path = realpath(Name, 0);
+#endif
+   char *Result;
+
+   if (Path == 0) {
+      return xstrdup(Name);
+   }
+   Result = xstrdup(Path);
+   free(Path);
+   return Result;
+}
+
+static int IsEmptyLine(const StrBuf *L)
+// Return true if the line contains white space only
+{
+   unsigned I;
+
+   for (I = 0; I < SB_GetLen(L); ++I) {
+      if (!IsSpace(SB_AtUnchecked(L, I))) {
+         return 0;
+      }
+   }
+   return 1;
+}
+
+static void AppendMacros(StrBuf *B, char Tag)
+// Append all macros in the macro table to B
+{
+   Collection Macros = AUTO_COLLECTION_INITIALIZER;
+   char Buf[64];
+   unsigned I, J;
+
+   CollectMacros(&Macros);
+   for (I = 0; I < CollCount(&Macros); ++I) {
+      const Macro *M = CollConstAt(&Macros, I);
+      if (IsVolatileMacro(M->Name)) {
+         continue;
+      }
+      xsprintf(Buf, sizeof(Buf), "%c %u %u %d ", Tag, M->Predefined,
+               M->Variadic, M->ParamCount);
+      SB_AppendStr(B, Buf);
+      SB_AppendStr(B, M->Name);
+      for (J = 0; J < CollCount(&M->Params); ++J) {
+         SB_AppendChar(B, ' ');
+         SB_AppendStr(B, CollConstAt(&M->Params, J));
+      }
+      SB_AppendChar(B, '\n');
+      SB_Append(B, &M->Replacement);
+      SB_AppendChar(B, '\n');
+   }
+   DoneCollection(&Macros);
+}
+
+static int ReadLine(FILE *F, StrBuf *L)
+// Read a line without the newline into L. Return false at the end of file.
+{
+   int C;
+
+   SB_Clear(L);
+   while ((C = getc(F)) != EOF && C != '\n') {
+      SB_AppendChar(L, C);
+   }
+   SB_Terminate(L);
+   return C != EOF || SB_NotEmpty(L);
+}
+
+static char *NextWord(char **P)
+// Return the next word from *P, and skip it and the following blank
+{
+   char *Word = *P;
+   char *End = strchr(Word, ' ');
+
+   if (End) {
+      *End = '\0';
+      *P = End + 1;
+   }
+   else {
+      *P = Word + strlen(Word);
+   }
+   return Word;
+}
+
+static Macro *ReadMacro(FILE *F, char *Def)
+// Read a macro from the rest of its definition line and from the following
+// line with the replacement text. Return NULL on errors.
+{
+   StrBuf L = AUTO_STRBUF_INITIALIZER;
+   unsigned Predefined, Variadic;
+   int ParamCount;
+   int Len;
+   Macro *M;
+
+   if (sscanf(Def, "%u %u %d %n", &Predefined, &Variadic, &ParamCount,
+              &Len) != 3 ||
+       Def[Len] == '\0') {
+      return 0;
+   }
+   Def += Len;
+   M = NewMacro(NextWord(&Def), Predefined);
+   M->Variadic = Variadic;
+   M->ParamCount = ParamCount;
+   while (*Def) {
+      CollAppend(&M->Params, xstrdup(NextWord(&Def)));
+   }
+
+   if (!ReadLine(F, &L)) {
+      FreeMacro(M);
+      M = 0;
+   }
+   else {
+      SB_Copy(&M->Replacement, &L);
+   }
+   SB_Done(&L);
+   return M;
+}
+
+static PchFile *ReadPchFile(char *Def)
+// Read an input file from the rest of its line. Return NULL on errors.
+{
+   unsigned Type;
+   unsigned long Size, MTime;
+   char *Guard;
+   int Len;
+   PchFile *PF;
+
+   if (sscanf(Def, "%u %lu %lu %n", &Type, &Size, &MTime, &Len) != 3) {
+      return 0;
+   }
+   Def += Len;
+   Guard = NextWord(&Def);
+   if (*Guard == '\0' || *Def == '\0') {
+      return 0;
+   }
+
+   PF = xmalloc(sizeof(PchFile));
+   PF->Type = (InputType)Type;
+   PF->Size = Size;
+   PF->MTime = MTime;
+   PF->Guard = strcmp(Guard, "-") == 0 ? 0 : xstrdup(Guard);
+   PF->Name = xstrdup(Def);
+   return PF;
+}
+
+static const char *ReadPch(FILE *F, Collection *Initial)
+// Read a precompiled header up to the text. The macros before the header
+// are added to Initial. Return a description of the problem on errors, or
+// NULL if the file was read.
+{
+   StrBuf L = AUTO_STRBUF_INITIALIZER;
+   const char *Problem = 0;
+   unsigned Format, Version;
+
+   // Check the version
+   if (!ReadLine(F, &L) ||
+       sscanf(SB_GetConstBuf(&L), "cc65 pch %u %u", &Format, &Version) != 2 ||
+       Format != PCH_FORMAT || Version != GetVersionAsNumber()) {
+      SB_Done(&L);
+      return "Not made by this version of the compiler";
+   }
+
+   // Read the records up to the text
+   while (Problem == 0) {
+
+      char *P;
+      void *Item;
+
+      if (!ReadLine(F, &L) || SB_GetLen(&L) < 1) {
+         Problem = "File is damaged";
+         break;
+      }
+      P = SB_GetBuf(&L);
+      if (P[0] == 'T' && P[1] == '\0') {
+         break;
+      }
+      if (P[1] != ' ') {
+         Problem = "File is damaged";
+         break;
+      }
+
+      switch (P[0]) {
+         case 'H':
+            if (PchHeader == 0) {
+               Item = PchHeader = xstrdup(P + 2);
+            }
+            else {
+               Item = 0;
+            }
+            break;
+         case 'F':
+            if ((Item = ReadPchFile(P + 2)) != 0) {
+               CollAppend(&PchFiles, Item);
+            }
+            break;
+         case 'I':
+            if ((Item = ReadMacro(F, P + 2)) != 0) {
+               CollAppend(Initial, Item);
+            }
+            break;
+         case 'M':
+            if ((Item = ReadMacro(F, P + 2)) != 0) {
+               CollAppend(&PchMacros, Item);
+            }
+            break;
+         default:
+            Item = 0;
+            break;
+      }
+      if (Item == 0) {
+         Problem = "File is damaged";
+      }
+   }
+
+   if (Problem == 0 && (PchHeader == 0 || CollCount(&PchFiles) == 0)) {
+      Problem = "File is damaged";
+   }
+   SB_Done(&L);
+   return Problem;
+}
+
+static int SameMacros(const Collection *Macros)
+// Return true if the macro table contains exactly the given macros, not
+// counting volatile macros.
+{
+   Collection Current = AUTO_COLLECTION_INITIALIZER;
+   unsigned Count = 0;
+   unsigned I;
+
+   CollectMacros(&Current);
+   for (I = 0; I < CollCount(&Current); ++I) {
+      const Macro *M = CollConstAt(&Current, I);
+      if (!IsVolatileMacro(M->Name)) {
+         ++Count;
+      }
+   }
+   DoneCollection(&Current);
+   if (Count != CollCount(Macros)) {
+      return 0;
+   }
+
+   for (I = 0; I < CollCount(Macros); ++I) {
+      const Macro *M = CollConstAt(Macros, I);
+      const Macro *Cur = FindMacro(M->Name);
+      if (Cur == 0 || MacroCmp(Cur, M) != 0 || Cur->Variadic != M->Variadic ||
+          Cur->Predefined != M->Predefined) {
+         return 0;
+      }
+   }
+   return 1;
+}
+
+static void FreeMacros(Collection *Macros)
+// Free all macros in the collection
+{
+   unsigned I;
+
+   for (I = 0; I < CollCount(Macros); ++I) {
+      FreeMacro(CollAtUnchecked(Macros, I));
+   }
+   CollDeleteAll(Macros);
+}
+
+static void FreePchFiles(void)
+// Free the input files of the precompiled header
+{
+   unsigned I;
+
+   xfree(PchHeader);
+   PchHeader = 0;
+   for (I = 0; I < CollCount(&PchFiles); ++I) {
+      PchFile *PF = CollAtUnchecked(&PchFiles, I);
+      xfree(PF->Guard);
+      xfree(PF->Name);
+      xfree(PF);
+   }
+   CollDeleteAll(&PchFiles);
+   CollDeleteAll(&InputFiles);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                   Code
+////////////////////////////////////////////////////////////////////////////////
+
+void CreatePrecompiledHeader(void)
+// Preprocess the main file and write the result as a precompiled header
+{
+   const char *Name = SB_GetConstBuf(&CreatePchName);
+   StrBuf Initial = AUTO_STRBUF_INITIALIZER;
+   StrBuf Final = AUTO_STRBUF_INITIALIZER;
+   StrBuf Text = AUTO_STRBUF_INITIALIZER;
+   const IFile *Last = 0;
+   unsigned LastLine = 0;
+   char Buf[64];
+   FILE *F;
+   unsigned I;
+
+   // Remember the macros defined before the header
+   AppendMacros(&Initial, 'I');
+
+   // Preprocess the header. Empty lines are left out, so the position in
+   // the input files is added when lines are skipped.
+   while (PreprocessNextLine()) {
+      const IFile *IF;
+      unsigned LineNum;
+
+      if (IsEmptyLine(Line)) {
+         continue;
+      }
+      IF = GetCurrentInputFile(&LineNum);
+      if (IF != Last || LineNum != LastLine + 1) {
+         xsprintf(Buf, sizeof(Buf), "#%u %u\n", IF->Index - 1, LineNum);
+         SB_AppendStr(&Text, Buf);
+      }
+      SB_Append(&Text, Line);
+      SB_AppendChar(&Text, '\n');
+      Last = IF;
+      LastLine = LineNum;
+   }
+
+   // Remember the macros defined after the header
+   AppendMacros(&Final, 'M');
+
+   // Write the file if there were no errors
+   if (GetTotalErrors() == 0) {
+
+      F = fopen(Name, "w");
+      if (F == 0) {
+         Fatal("Cannot open precompiled header file '%s': %s", Name,
+               strerror(errno));
+      }
+
+      char *Header = GetFullPath(GetInputFile(0)->Name);
+      fprintf(F, "cc65 pch %u %u\n", PCH_FORMAT, GetVersionAsNumber());
+      fprintf(F, "H %s\n", Header);
+      xfree(Header);
+      for (I = 0; I < GetInputFileCount(); ++I) {
+         const IFile *IF = GetInputFile(I);
+         int Guarded = (IF->GFlags & IG_ISGUARDED) != 0;
+         fprintf(F, "F %u %lu %lu %s %s\n", (unsigned)IF->Type, IF->Size,
+                 IF->MTime,
+                 Guarded ? SB_GetConstBuf(&IF->GuardMacro) : "-", IF->Name);
+      }
+      fwrite(SB_GetConstBuf(&Initial), 1, SB_GetLen(&Initial), F);
+      fwrite(SB_GetConstBuf(&Final), 1, SB_GetLen(&Final), F);
+      fputs("T\n", F);
+      fwrite(SB_GetConstBuf(&Text), 1, SB_GetLen(&Text), F);
+
+      if (ferror(F) || fclose(F) != 0) {
+         remove(Name);
+         Fatal("Cannot write to precompiled header file (disk full?)");
+      }
+      Print(stdout, 1, "Wrote precompiled header to '%s'\n", Name);
+   }
+
+   SB_Done(&Initial);
+   SB_Done(&Final);
+   SB_Done(&Text);
+}
+
+int OpenPrecompiledHeader(IFile *IF)
+// Read the precompiled header instead of the include file IF if it was made
+// from this file and can be used. Return true if it is read.
+{
+   const char *Name = SB_GetConstBuf(&UsePchName);
+   Collection Initial = AUTO_COLLECTION_INITIALIZER;
+   const char *Problem;
+   const PchFile *PF;
+   char *Header;
+   FILE *F;
+   unsigned I;
+
+   // Only the first include file of the main file may be replaced, so there
+   // is only one try
+   if (SB_IsEmpty(&UsePchName) || Tried) {
+      return 0;
+   }
+   Tried = 1;
+
+   // Open the file and read everything up to the text
+   F = fopen(Name, "r");
+   if (F == 0) {
+      PPWarning("Cannot open precompiled header '%s': %s", Name,
+                strerror(errno));
+      return 0;
+   }
+   Problem = ReadPch(F, &Initial);
+
+   // A header made from another file is silently ignored. The files are
+   // compared by their full paths, since headers in different directories
+   // may have the same name.
+   if (Problem == 0) {
+      Header = GetFullPath(IF->Name);
+      if (strcmp(PchHeader, Header) != 0) {
+         xfree(Header);
+         Print(stdout, 1, "Precompiled header '%s' is not for '%s'\n", Name,
+               IF->Name);
+         fclose(F);
+         FreeMacros(&Initial);
+         FreeMacros(&PchMacros);
+         FreePchFiles();
+         DoneCollection(&Initial);
+         return 0;
+      }
+      xfree(Header);
+   }
+
+   // All input files must be unchanged
+   for (I = 0; Problem == 0 && I < CollCount(&PchFiles); ++I) {
+      struct stat Buf;
+      PF = CollConstAt(&PchFiles, I);
+      if (FileStat(I == 0 ? IF->Name : PF->Name, &Buf) != 0 ||
+          (unsigned long)Buf.st_size != PF->Size ||
+          (unsigned long)Buf.st_mtime != PF->MTime) {
+         Problem = "Input files have changed";
+      }
+   }
+
+   // The macros before the header must be the same, otherwise the header may
+   // have a different meaning
+   if (Problem == 0 && !SameMacros(&Initial)) {
+      Problem = "Macros defined before the header are different";
+   }
+   FreeMacros(&Initial);
+   DoneCollection(&Initial);
+
+   if (Problem) {
+      PPWarning("Precompiled header '%s' not used: %s", Name, Problem);
+      fclose(F);
+      FreeMacros(&PchMacros);
+      FreePchFiles();
+      return 0;
+   }
+
+   // Read the text instead of the header. The other input files are added
+   // after the header, so they are listed in the same order as without a
+   // precompiled header.
+   CollAppend(&InputFiles, IF);
+   OpenPrecompiledFile(IF, F, &InputFiles);
+   for (I = 1; I < CollCount(&PchFiles); ++I) {
+      PF = CollConstAt(&PchFiles, I);
+      CollAppend(&InputFiles,
+                 AddPrecompiledFile(PF->Name, PF->Type, PF->Size, PF->MTime));
+   }
+   return 1;
+}
+
+void ClosePrecompiledHeader(void)
+// Restore the preprocessor state after the original header at the end of a
+// precompiled header
+{
+   Collection Current = AUTO_COLLECTION_INITIALIZER;
+   unsigned I;
+
+   // Replace the macros by the ones defined after the header
+   CollectMacros(&Current);
+   for (I = 0; I < CollCount(&Current); ++I) {
+      const Macro *M = CollConstAt(&Current, I);
+      if (!IsVolatileMacro(M->Name)) {
+         UndefineMacro(M->Name);
+      }
+   }
+   DoneCollection(&Current);
+   for (I = 0; I < CollCount(&PchMacros); ++I) {
+      InsertMacro(CollAtUnchecked(&PchMacros, I));
+   }
+   CollDeleteAll(&PchMacros);
+
+   // Set the include guards, so the files aren't read again
+   for (I = 0; I < CollCount(&PchFiles); ++I) {
+      const PchFile *PF = CollConstAt(&PchFiles, I);
+      if (PF->Guard) {
+         IFile *IF = CollAtUnchecked(&InputFiles, I);
+         IF->GFlags |= IG_ISGUARDED;
+         SB_CopyStr(&IF->GuardMacro, PF->Guard);
+         SB_Terminate(&IF->GuardMacro);
+      }
+   }
+}
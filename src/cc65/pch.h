@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//                                   pch.h
+//
+//                           Precompiled headers
+//
+//
+//
+// (C) 2026, The cc65 Authors
+//
+//
+// This software is provided 'as-is', without any expressed or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PCH_H
+#define PCH_H
+
+////////////////////////////////////////////////////////////////////////////////
+//                                 Forwards
+////////////////////////////////////////////////////////////////////////////////
+
+struct IFile;
+
+////////////////////////////////////////////////////////////////////////////////
+//                                   Code
+////////////////////////////////////////////////////////////////////////////////
+
+void CreatePrecompiledHeader(void);
+// Preprocess the main file and write the result as a precompiled header
+
+int OpenPrecompiledHeader(struct IFile *IF);
+// Read the precompiled header instead of the include file IF if it was made
+// from this file and can be used. Return true if it is read.
+
+void ClosePrecompiledHeader(void);
+// Restore the preprocessor state after the original header at the end of a
+// precompiled header
+
+// End of pch.h
+#endif
@@ -0,0 +1,262 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//                                 profile.c
+//
+//             Execution profiles for profile guided optimization
+//
+//
+//
+// (C) 2026, The cc65 Authors
+//
+//
+// This software is provided 'as-is', without any expressed or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+// common
+#include "abend.h"
+#include "chartype.h"
+#include "coll.h"
+#include "fname.h"
+#include "xmalloc.h"
+
+// cc65
+#include "global.h"
+#include "lineinfo.h"
+#include "profile.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//                                   Data
+////////////////////////////////////////////////////////////////////////////////
+
+// A line is hot if it was executed at least 1/HOT_FRACTION as often as the
+// most executed line of the profile.
+#define HOT_FRACTION 64
+
+// Execution counts for one source file
+typedef struct ProfFile ProfFile;
+struct ProfFile {
+   char *Name;            // Name of the file as given in the profile
+   unsigned Size;         // Number of entries in Counts
+   unsigned long *Counts; // Count per line plus one, zero if unknown
+};
+
+// All files of the profile
+static Collection ProfFiles = STATIC_COLLECTION_INITIALIZER;
+
+// Minimum count of a hot line
+static unsigned long HotCount = 0;
+
+// Cache for the last lookup, since consecutive statements are usually in
+// the same file.
+static char *LastName = 0;
+static ProfFile *LastFile = 0;
+
+// Heat of the statement being compiled. It is kept apart from the option
+// stacks, so it never changes the settings made with pragmas.
+static profheat_t StmtHeat = PH_NONE;
+
+////////////////////////////////////////////////////////////////////////////////
+//                                   Code
+////////////////////////////////////////////////////////////////////////////////
+
+static ProfFile *GetProfFile(const char *Name)
+// Return the entry for the given file name, creating it if needed
+{
+   ProfFile *F;
+   unsigned I;
+
+   for (I = 0; I < CollCount(&ProfFiles); ++I) {
+      F = CollAtUnchecked(&ProfFiles, I);
+      if (strcmp(F->Name, Name) == 0) {
+         return F;
+      }
+   }
+
+   F = xmalloc(sizeof(ProfFile));
+   F->Name = xstrdup(Name);
+   F->Size = 0;
+   F->Counts = 0;
+   CollAppend(&ProfFiles, F);
+   return F;
+}
+
+static void AddCount(ProfFile *F, unsigned Line, unsigned long Count)
+// Add the execution count of a line. Counts from several records for the
+// same file are summed up.
+{
+   if (Line >= F->Size) {
+      unsigned NewSize = F->Size ? F->Size : 64;
+      while (NewSize <= Line) {
+         NewSize *= 2;
+      }
+      F->Counts = xrealloc(F->Counts, NewSize * sizeof(F->Counts[0]));
+      memset(F->Counts + F->Size, 0,
+             (NewSize - F->Size) * sizeof(F->Counts[0]));
+      F->Size = NewSize;
+   }
+   if (F->Counts[Line] == 0) {
+      F->Counts[Line] = 1;
+   }
+   F->Counts[Line] += Count;
+}
+
+void ReadProfile(const char *Name)
+// Read an execution profile in lcov format as written by sim65 --coverage
+{
+   char Buf[1024];
+   ProfFile *F = 0;
+   unsigned long MaxCount = 0;
+   unsigned I, J;
+
+   // Open the file
+   FILE *P = fopen(Name, "r");
+   if (P == 0) {
+      AbEnd("Cannot open '%s': %s", Name, strerror(errno));
+   }
+
+   // Only the source file and the line records are of interest
+   while (fgets(Buf, sizeof(Buf), P) != 0) {
+
+      unsigned Len = strlen(Buf);
+      while (Len > 0 && IsControl(Buf[Len - 1])) {
+         --Len;
+      }
+      Buf[Len] = '\0';
+
+      if (strncmp(Buf, "SF:", 3) == 0) {
+         F = GetProfFile(Buf + 3);
+      }
+      else if (strcmp(Buf, "end_of_record") == 0) {
+         F = 0;
+      }
+      else if (F && strncmp(Buf, "DA:", 3) == 0) {
+         unsigned Line;
+         unsigned long Count;
+         if (sscanf(Buf + 3, "%u,%lu", &Line, &Count) == 2) {
+            AddCount(F, Line, Count);
+         }
+      }
+   }
+   fclose(P);
+
+   // Determine the threshold for hot lines. Lines executed only once are
+   // never hot.
+   for (I = 0; I < CollCount(&ProfFiles); ++I) {
+      F = CollAtUnchecked(&ProfFiles, I);
+      for (J = 0; J < F->Size; ++J) {
+         if (F->Counts[J] > MaxCount + 1) {
+            MaxCount = F->Counts[J] - 1;
+         }
+      }
+   }
+   HotCount = MaxCount / HOT_FRACTION;
+   if (HotCount < 2) {
+      HotCount = 2;
+   }
+}
+
+static ProfFile *FindProfFile(const char *Name)
+// Find the profile data for a source file. Since the profile may have been
+// made in another directory, the file name without the path is also accepted.
+{
+   ProfFile *Match = 0;
+   unsigned I;
+
+   for (I = 0; I < CollCount(&ProfFiles); ++I) {
+      ProfFile *F = CollAtUnchecked(&ProfFiles, I);
+      if (strcmp(F->Name, Name) == 0) {
+         return F;
+      }
+      if (Match == 0 && strcmp(FindName(F->Name), FindName(Name)) == 0) {
+         Match = F;
+      }
+   }
+   return Match;
+}
+
+profheat_t GetProfileHeat(const LineInfo *LI)
+// Return the heat of the given source line
+{
+   const char *Name;
+   unsigned Line;
+   unsigned long Count;
+
+   if (CollCount(&ProfFiles) == 0 || LI == 0) {
+      return PH_NONE;
+   }
+
+   Name = GetActualFileName(LI);
+   if (LastName == 0 || strcmp(LastName, Name) != 0) {
+      xfree(LastName);
+      LastName = xstrdup(Name);
+      LastFile = FindProfFile(Name);
+   }
+
+   Line = GetActualLineNum(LI);
+   if (LastFile == 0 || Line >= LastFile->Size ||
+       (Count = LastFile->Counts[Line]) == 0) {
+      return PH_NONE;
+   }
+   if (Count == 1) {
+      return PH_COLD;
+   }
+   return Count - 1 >= HotCount ? PH_HOT : PH_WARM;
+}
+
+profheat_t SetStatementHeat(profheat_t Heat)
+// Set the heat of the statement being compiled and return the old one
+{
+   profheat_t OldHeat = StmtHeat;
+   StmtHeat = Heat;
+   return OldHeat;
+}
+
+long GetCodeSizeFactor(void)
+// Return the code size factor for the statement being compiled. This is the
+// one from the command line or the pragma, raised for hot statements and
+// lowered for cold ones.
+{
+   long CodeSize = IS_Get(&CodeSizeFactor);
+
+   if (StmtHeat == PH_HOT && CodeSize < PROFILE_HOT_CODESIZE) {
+      CodeSize = PROFILE_HOT_CODESIZE;
+   }
+   else if (StmtHeat == PH_COLD && CodeSize > PROFILE_COLD_CODESIZE) {
+      CodeSize = PROFILE_COLD_CODESIZE;
+   }
+   return CodeSize;
+}
+
+int GetInlineStdFuncs(void)
+// Return true if standard functions may be inlined in the statement being
+// compiled. They are always inlined in hot statements, and never in cold
+// ones.
+{
+   if (StmtHeat == PH_HOT) {
+      return 1;
+   }
+   else if (StmtHeat == PH_COLD) {
+      return 0;
+   }
+   return (int)IS_Get(&InlineStdFuncs);
+}
@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//                                 profile.h
+//
+//             Execution profiles for profile guided optimization
+//
+//
+//
+// (C) 2026, The cc65 Authors
+//
+//
+// This software is provided 'as-is', without any expressed or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+////////////////////////////////////////////////////////////////////////////////
+//                                 Forwards
+////////////////////////////////////////////////////////////////////////////////
+
+struct LineInfo;
+
+////////////////////////////////////////////////////////////////////////////////
+//                                   Data
+////////////////////////////////////////////////////////////////////////////////
+
+// How often a source line was executed in the profile run. The values are
+// ordered, so the heat of a function is the maximum of its statements.
+typedef enum {
+   PH_NONE, // No profile data for the line
+   PH_COLD, // The line was never executed
+   PH_WARM, // The line was executed
+   PH_HOT,  // The line is among the most executed ones
+} profheat_t;
+
+// Code size factors used for hot and cold code
+#define PROFILE_HOT_CODESIZE 200
+#define PROFILE_COLD_CODESIZE 100
+
+////////////////////////////////////////////////////////////////////////////////
+//                                   Code
+////////////////////////////////////////////////////////////////////////////////
+
+void ReadProfile(const char *Name);
+// Read an execution profile in lcov format as written by sim65 --coverage
+
+profheat_t GetProfileHeat(const struct LineInfo *LI);
+// Return the heat of the given source line
+
+profheat_t SetStatementHeat(profheat_t Heat);
+// Set the heat of the statement being compiled and return the old one
+
+long GetCodeSizeFactor(void);
+// Return the code size factor for the statement being compiled. This is the
+// one from the command line or the pragma, raised for hot statements and
+// lowered for cold ones.
+
+int GetInlineStdFuncs(void);
+// Return true if standard functions may be inlined in the statement being
+// compiled. They are always inlined in hot statements, and never in cold
+// ones.
+
+// End of profile.h
+#endif
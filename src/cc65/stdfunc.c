@@ -37,6 +37,7 @@
 // common
 #include "attrib.h"
 #include "check.h"
+#include "tgttrans.h"
 
 // cc65
 #include "asmcode.h"
@@ -47,6 +48,7 @@
 #include "global.h"
 #include "litpool.h"
 #include "loadexpr.h"
+#include "profile.h"
 #include "scanner.h"
 #include "seqpoint.h"
 #include "stackptr.h"
@@ -58,8 +60,12 @@
 //                             Function forwards
 ////////////////////////////////////////////////////////////////////////////////
 
+static void StdFunc_memchr(FuncDesc *, ExprDesc *);
+static void StdFunc_memcmp(FuncDesc *, ExprDesc *);
 static void StdFunc_memcpy(FuncDesc *, ExprDesc *);
 static void StdFunc_memset(FuncDesc *, ExprDesc *);
+static void StdFunc_strcat(FuncDesc *, ExprDesc *);
+static void StdFunc_strchr(FuncDesc *, ExprDesc *);
 static void StdFunc_strcmp(FuncDesc *, ExprDesc *);
 static void StdFunc_strcpy(FuncDesc *, ExprDesc *);
 static void StdFunc_strlen(FuncDesc *, ExprDesc *);
@@ -75,17 +81,43 @@ static struct StdFuncDesc {
    void (*Handler)(FuncDesc *, ExprDesc *);
 } StdFuncs[] = {
     // BEGIN SORTED.SH
+    {"memchr", StdFunc_memchr}, {"memcmp", StdFunc_memcmp},
     {"memcpy", StdFunc_memcpy}, {"memset", StdFunc_memset},
+    {"strcat", StdFunc_strcat}, {"strchr", StdFunc_strchr},
     {"strcmp", StdFunc_strcmp}, {"strcpy", StdFunc_strcpy},
     {"strlen", StdFunc_strlen},
     // END SORTED.SH
 };
 #define FUNC_COUNT (sizeof(StdFuncs) / sizeof(StdFuncs[0]))
 
+// Table with the printf like functions that may use a precompiled format.
+// CAUTION: table must be alphabetically sorted for bsearch
+static struct PrintfFuncDesc {
+   const char *Name;     // Name of the function
+   unsigned FmtIndex;    // Index of the format argument
+   const char *DescName; // Function taking a format descriptor
+} PrintfFuncs[] = {
+    // BEGIN SORTED.SH
+    {"fprintf", 1, "_fprintfd"},
+    {"printf", 0, "_printfd"},
+    {"snprintf", 2, "_snprintfd"},
+    {"sprintf", 1, "_sprintfd"},
+    // END SORTED.SH
+};
+#define PRINTF_FUNC_COUNT (sizeof(PrintfFuncs) / sizeof(PrintfFuncs[0]))
+
+// Descriptor codes of a precompiled printf format
+#define PD_END       0x00 // End of the descriptor
+#define PD_MAXRUN    0x7F // Maximum count of literal characters in a run
+#define PD_CONV      0x80 // Conversion, followed by width and conversion char
+#define PD_LEFTJUST  0x01 // Conversion flag '-'
+#define PD_ZEROPAD   0x02 // Conversion flag '0'
+
 typedef struct ArgDesc ArgDesc;
 struct ArgDesc {
    const Type *ArgType; // Required argument type
    ExprDesc Expr;       // Argument expression
+   ExprDesc Orig;       // The original expression before conversion
    const Type *Type;    // The original type before conversion
    CodeMark Load;       // Start of argument load code
    CodeMark Push;       // Start of argument push code
@@ -139,6 +171,9 @@ static void ParseArg(ArgDesc *Arg, const Type *Type, ExprDesc *Expr)
    // Read the expression we're going to pass to the function
    MarkedExprWithCheck(hie1, &Arg->Expr);
 
+   // Remember the expression before it is converted and loaded
+   Arg->Orig = Arg->Expr;
+
    // Remember the actual argument type
    Arg->Type = Arg->Expr.Type;
 
@@ -180,6 +215,287 @@ void AddCmpCodeIfSizeNot256(const char *Code, long Size)
    }
 }
 
+static int InlineSizeOk(unsigned InlineSize, unsigned CallSize)
+// Decide between inline code and a call of the library function by their
+// sizes in bytes. The code size factor tells how much larger than the call
+// the inline code may be.
+{
+   return (long)InlineSize * 100 <= (long)CallSize * GetCodeSizeFactor();
+}
+
+static int IsIndexableAddr(const ExprDesc *Expr)
+// Return true if the memory at the given address can be accessed with the Y
+// register as index: The address is constant, or it is a pointer in a zero
+// page location.
+{
+   return ED_IsConstAddr(Expr) || ED_IsZPInd(Expr);
+}
+
+static int AllowNegOffs(const ExprDesc *Expr)
+// Return true if the given constant address may be used with a negative
+// offset. This is not possible for data in the register space or at an
+// absolute address less than 256, since the address calculation could
+// overflow in the linker.
+{
+   return ED_IsConstAddr(Expr) && !ED_IsLocZP(Expr) &&
+          !(ED_IsLocNone(Expr) && Expr->IVal < 256);
+}
+
+static void AddIndexedCodeLine(const char *Insn, const ExprDesc *Expr, long Offs)
+// Add an instruction that accesses the memory at the given address with the
+// Y register as index. Offs is added to a constant address.
+{
+   if (ED_IsZPInd(Expr)) {
+      AddCodeLine("%s (%s),y", Insn, ED_GetLabelName(Expr, 0));
+   }
+   else {
+      AddCodeLine("%s %s,y", Insn, ED_GetLabelName(Expr, Offs));
+   }
+}
+
+static void AddAddrPlusY(const ExprDesc *Expr, unsigned Fin)
+// Add code that loads the given address plus the Y register into the
+// primary. The code jumps to the label Fin when done.
+{
+   AddCodeLine("tya");
+   AddCodeLine("clc");
+   if (ED_IsZPInd(Expr)) {
+      AddCodeLine("adc %s", ED_GetLabelName(Expr, 0));
+      AddCodeLine("ldx %s", ED_GetLabelName(Expr, 1));
+   }
+   else {
+      AddCodeLine("adc #<(%s)", ED_GetLabelName(Expr, 0));
+      AddCodeLine("ldx #>(%s)", ED_GetLabelName(Expr, 0));
+   }
+   AddCodeLine("bcc %s", LocalLabelName(Fin));
+   AddCodeLine("inx");
+}
+
+static int IsByteSizeArg(const ArgDesc *Arg)
+// Return true if the argument is an unsigned char variable that can be loaded
+// without the code generated for it. The value of such a size is less than
+// 256 by its type.
+{
+   const ExprDesc *E = &Arg->Orig;
+
+   if (!IsClassInt(Arg->Type) || !IsRankChar(Arg->Type) ||
+       !IsSignUnsigned(Arg->Type) || IsTypeBitField(Arg->Type)) {
+      return 0;
+   }
+   if (!ED_IsLVal(E) || (E->Flags & E_SIDE_EFFECTS) != 0 || ED_IsLocNone(E)) {
+      return 0;
+   }
+   return ED_IsLocConst(E) || (ED_IsLocStack(E) && ED_GetStackOffs(E, 0) < 256);
+}
+
+static void LoadByteSize(const ArgDesc *Arg)
+// Load a size argument checked by IsByteSizeArg into the Y register. The
+// flags reflect the value.
+{
+   const ExprDesc *E = &Arg->Orig;
+
+   if (ED_IsLocStack(E)) {
+      AddCodeLine("ldy #$%02X", (unsigned char)ED_GetStackOffs(E, 0));
+      AddCodeLine("lda (c_sp),y");
+      AddCodeLine("tay");
+   }
+   else {
+      AddCodeLine("ldy %s", ED_GetLabelName(E, 0));
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                  memchr
+////////////////////////////////////////////////////////////////////////////////
+
+static void StdFunc_memchr(FuncDesc *F attribute((unused)), ExprDesc *Expr)
+// Handle the memchr function
+{
+   // Argument types: (const void*, int, size_t)
+   static const Type *Arg1Type = type_c_void_p;
+   static const Type *Arg2Type = type_int;
+   static const Type *Arg3Type = type_size_t;
+
+   ArgDesc Arg1, Arg2, Arg3;
+   unsigned ParamSize = 0;
+   unsigned Loop, Found, Fin; // Labels
+
+   // Argument #1
+   ParseArg(&Arg1, Arg1Type, Expr);
+   g_push(Arg1.Flags, Arg1.Expr.IVal);
+   GetCodePos(&Arg1.End);
+   ParamSize += SizeOf(Arg1Type);
+   ConsumeComma();
+
+   // Argument #2
+   ParseArg(&Arg2, Arg2Type, Expr);
+   g_push(Arg2.Flags, Arg2.Expr.IVal);
+   GetCodePos(&Arg2.End);
+   ParamSize += SizeOf(Arg2Type);
+   ConsumeComma();
+
+   // Argument #3. Since memchr is a fastcall function, we must load the
+   // arg into the primary if it is not already there. This parameter is
+   // also ignored for the calculation of the parameter size, since it is
+   // not passed via the stack.
+   ParseArg(&Arg3, Arg3Type, Expr);
+   if (Arg3.Flags & CF_CONST) {
+      LoadExpr(CF_NONE, &Arg3.Expr);
+   }
+
+   // We still need to append deferred inc/dec before calling into the function
+   DoDeferred(SQP_KEEP_EAX, &Arg3.Expr);
+
+   // Emit the actual function call. This will also cleanup the stack.
+   g_call(CF_FIXARGC, Func_memchr, ParamSize);
+
+   // Inline the function if the memory is addressable with the Y register,
+   // the character and the size are constant, and the code size factor
+   // allows 29 bytes of inline code instead of a call with about 20 bytes.
+   if (GetInlineStdFuncs() && IsIndexableAddr(&Arg1.Expr) &&
+       ED_IsConstAbsInt(&Arg2.Expr) && ED_IsConstAbsInt(&Arg3.Expr) &&
+       Arg3.Expr.IVal >= 1 && Arg3.Expr.IVal <= 256 && InlineSizeOk(29, 20)) {
+
+      // Drop the generated code
+      RemoveCode(&Arg1.Expr.Start);
+
+      // We need labels
+      Loop = GetLocalLabel();
+      Found = GetLocalLabel();
+      Fin = GetLocalLabel();
+
+      // Generate memchr code
+      AddCodeLine("ldy #$00");
+      g_defcodelabel(Loop);
+      AddIndexedCodeLine("lda", &Arg1.Expr, 0);
+      AddCodeLine("cmp #$%02X", (unsigned char)Arg2.Expr.IVal);
+      AddCodeLine("beq %s", LocalLabelName(Found));
+      AddCodeLine("iny");
+      AddCmpCodeIfSizeNot256("cpy #$%02X", Arg3.Expr.IVal);
+      AddCodeLine("bne %s", LocalLabelName(Loop));
+      AddCodeLine("lda #$00");
+      AddCodeLine("tax");
+      AddCodeLine("beq %s", LocalLabelName(Fin));
+      g_defcodelabel(Found);
+      AddAddrPlusY(&Arg1.Expr, Fin);
+      g_defcodelabel(Fin);
+   }
+
+   // The function result is an rvalue in the primary register
+   ED_FinalizeRValLoad(Expr);
+   Expr->Type = GetFuncReturnType(Expr->Type);
+
+   // We expect the closing brace
+   ConsumeRParen();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                  memcmp
+////////////////////////////////////////////////////////////////////////////////
+
+static void StdFunc_memcmp(FuncDesc *F attribute((unused)), ExprDesc *Expr)
+// Handle the memcmp function
+{
+   // Argument types: (const void*, const void*, size_t)
+   static const Type *Arg1Type = type_c_void_p;
+   static const Type *Arg2Type = type_c_void_p;
+   static const Type *Arg3Type = type_size_t;
+
+   ArgDesc Arg1, Arg2, Arg3;
+   unsigned ParamSize = 0;
+   unsigned Entry, Loop, Diff, Fin; // Labels
+   int ConstSize;
+   int VarSize;
+
+   // Argument #1
+   ParseArg(&Arg1, Arg1Type, Expr);
+   g_push(Arg1.Flags, Arg1.Expr.IVal);
+   GetCodePos(&Arg1.End);
+   ParamSize += SizeOf(Arg1Type);
+   ConsumeComma();
+
+   // Argument #2
+   ParseArg(&Arg2, Arg2Type, Expr);
+   g_push(Arg2.Flags, Arg2.Expr.IVal);
+   GetCodePos(&Arg2.End);
+   ParamSize += SizeOf(Arg2Type);
+   ConsumeComma();
+
+   // Argument #3. Since memcmp is a fastcall function, we must load the
+   // arg into the primary if it is not already there. This parameter is
+   // also ignored for the calculation of the parameter size, since it is
+   // not passed via the stack.
+   ParseArg(&Arg3, Arg3Type, Expr);
+   if (Arg3.Flags & CF_CONST) {
+      LoadExpr(CF_NONE, &Arg3.Expr);
+   }
+
+   // We still need to append deferred inc/dec before calling into the function
+   DoDeferred(SQP_KEEP_EAX, &Arg3.Expr);
+
+   // Emit the actual function call. This will also cleanup the stack.
+   g_call(CF_FIXARGC, Func_memcmp, ParamSize);
+
+   // The size must be a constant in the range 1..256, or an unsigned char
+   // variable with a constant address, so the index register can be compared
+   // against it.
+   ConstSize = ED_IsConstAbsInt(&Arg3.Expr) && Arg3.Expr.IVal >= 1 &&
+               Arg3.Expr.IVal <= 256;
+   VarSize = IsByteSizeArg(&Arg3) && ED_IsLocConst(&Arg3.Orig);
+
+   // Inline the function if both memory areas are addressable with the Y
+   // register, and the code size factor allows 26 bytes of inline code
+   // instead of a call with about 22 bytes.
+   if (GetInlineStdFuncs() && (ConstSize || VarSize) &&
+       IsIndexableAddr(&Arg1.Expr) && IsIndexableAddr(&Arg2.Expr) &&
+       InlineSizeOk(26, 22)) {
+
+      // Drop the generated code
+      RemoveCode(&Arg1.Expr.Start);
+
+      // We need labels
+      Entry = GetLocalLabel();
+      Loop = GetLocalLabel();
+      Diff = GetLocalLabel();
+      Fin = GetLocalLabel();
+
+      // Generate memcmp code. The result is zero if the areas are equal,
+      // otherwise the sign is in X as with the inlined strcmp.
+      AddCodeLine("ldx #$00");
+      AddCodeLine("ldy #$00");
+      if (VarSize) {
+         AddCodeLine("beq %s", LocalLabelName(Entry));
+      }
+      g_defcodelabel(Loop);
+      AddIndexedCodeLine("lda", &Arg1.Expr, 0);
+      AddIndexedCodeLine("cmp", &Arg2.Expr, 0);
+      AddCodeLine("bne %s", LocalLabelName(Diff));
+      AddCodeLine("iny");
+      if (VarSize) {
+         g_defcodelabel(Entry);
+         AddCodeLine("cpy %s", ED_GetLabelName(&Arg3.Orig, 0));
+      }
+      else {
+         AddCmpCodeIfSizeNot256("cpy #$%02X", Arg3.Expr.IVal);
+      }
+      AddCodeLine("bne %s", LocalLabelName(Loop));
+      AddCodeLine("txa");
+      AddCodeLine("beq %s", LocalLabelName(Fin));
+      g_defcodelabel(Diff);
+      AddCodeLine("ldx #$01");
+      AddCodeLine("bcs %s", LocalLabelName(Fin));
+      AddCodeLine("ldx #$FF");
+      g_defcodelabel(Fin);
+   }
+
+   // The function result is an rvalue in the primary register
+   ED_FinalizeRValLoad(Expr);
+   Expr->Type = GetFuncReturnType(Expr->Type);
+
+   // We expect the closing brace
+   ConsumeRParen();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                  memcpy
 ////////////////////////////////////////////////////////////////////////////////
@@ -242,7 +558,7 @@ static void StdFunc_memcpy(FuncDesc *F attribute((unused)), ExprDesc *Expr)
       goto ExitPoint;
    }
 
-   if (IS_Get(&InlineStdFuncs)) {
+   if (GetInlineStdFuncs()) {
 
       // We've generated the complete code for the function now and know the
       // types of all parameters. Check for situations where better code can
@@ -509,6 +825,48 @@ static void StdFunc_memcpy(FuncDesc *F attribute((unused)), ExprDesc *Expr)
          // Bail out, no need for further processing
          goto ExitPoint;
       }
+
+      // A size that is an unsigned char variable is less than 256. The
+      // inline code copies downwards and is smaller than the call, so it
+      // is always used.
+      if (IsByteSizeArg(&Arg3) && IsIndexableAddr(&Arg2.Expr) &&
+          IsIndexableAddr(&Arg1.Expr)) {
+
+         unsigned Fin;
+
+         // Drop the generated code
+         RemoveCode(&Arg1.Expr.Start);
+
+         // We need labels
+         Label = GetLocalLabel();
+         Fin = GetLocalLabel();
+
+         // Generate memcpy code. If possible, the addresses are adjusted,
+         // so the loop can use the flags from dey.
+         LoadByteSize(&Arg3);
+         AddCodeLine("beq %s", LocalLabelName(Fin));
+         g_defcodelabel(Label);
+         if (AllowNegOffs(&Arg2.Expr) && AllowNegOffs(&Arg1.Expr)) {
+            AddIndexedCodeLine("lda", &Arg2.Expr, -1);
+            AddIndexedCodeLine("sta", &Arg1.Expr, -1);
+            AddCodeLine("dey");
+         }
+         else {
+            AddCodeLine("dey");
+            AddIndexedCodeLine("lda", &Arg2.Expr, 0);
+            AddIndexedCodeLine("sta", &Arg1.Expr, 0);
+            AddCodeLine("tya");
+         }
+         AddCodeLine("bne %s", LocalLabelName(Label));
+         g_defcodelabel(Fin);
+
+         // memcpy returns the address, so the result is actually identical
+         // to the first argument.
+         *Expr = Arg1.Expr;
+
+         // Bail out, no need for further processing
+         goto ExitPoint;
+      }
    }
 
    // The function result is an rvalue in the primary register
@@ -590,7 +948,7 @@ static void StdFunc_memset(FuncDesc *F attribute((unused)), ExprDesc *Expr)
       goto ExitPoint;
    }
 
-   if (IS_Get(&InlineStdFuncs)) {
+   if (GetInlineStdFuncs()) {
 
       // We've generated the complete code for the function now and know the
       // types of all parameters. Check for situations where better code can
@@ -683,7 +1041,7 @@ static void StdFunc_memset(FuncDesc *F attribute((unused)), ExprDesc *Expr)
 
       if (ED_IsConstAbsInt(&Arg3.Expr) && Arg3.Expr.IVal <= 256 &&
           ED_IsConstAbsInt(&Arg2.Expr) &&
-          (Arg2.Expr.IVal != 0 || IS_Get(&CodeSizeFactor) > 200)) {
+          (Arg2.Expr.IVal != 0 || GetCodeSizeFactor() > 200)) {
 
          // Remove all of the generated code but the load of the first
          // argument.
@@ -724,6 +1082,38 @@ static void StdFunc_memset(FuncDesc *F attribute((unused)), ExprDesc *Expr)
          // Bail out, no need for further processing
          goto ExitPoint;
       }
+
+      // A size that is an unsigned char variable is less than 256. The
+      // inline code is smaller than the call, so it is always used.
+      if (IsByteSizeArg(&Arg3) && ED_IsConstAbsInt(&Arg2.Expr) &&
+          IsIndexableAddr(&Arg1.Expr)) {
+
+         unsigned Fin;
+
+         // Drop the generated code
+         RemoveCode(&Arg1.Expr.Start);
+
+         // We need labels
+         Label = GetLocalLabel();
+         Fin = GetLocalLabel();
+
+         // Generate memset code. The store doesn't change the flags.
+         LoadByteSize(&Arg3);
+         AddCodeLine("beq %s", LocalLabelName(Fin));
+         AddCodeLine("lda #$%02X", (unsigned char)Arg2.Expr.IVal);
+         g_defcodelabel(Label);
+         AddCodeLine("dey");
+         AddIndexedCodeLine("sta", &Arg1.Expr, 0);
+         AddCodeLine("bne %s", LocalLabelName(Label));
+         g_defcodelabel(Fin);
+
+         // memset returns the address, so the result is actually identical
+         // to the first argument.
+         *Expr = Arg1.Expr;
+
+         // Bail out, no need for further processing
+         goto ExitPoint;
+      }
    }
 
    // The function result is an rvalue in the primary register
@@ -735,6 +1125,176 @@ ExitPoint:
    ConsumeRParen();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//                                  strcat
+////////////////////////////////////////////////////////////////////////////////
+
+static void StdFunc_strcat(FuncDesc *F attribute((unused)), ExprDesc *Expr)
+// Handle the strcat function
+{
+   // Argument types: (char*, const char*)
+   static const Type *Arg1Type = type_char_p;
+   static const Type *Arg2Type = type_c_char_p;
+
+   ArgDesc Arg1, Arg2;
+   unsigned ParamSize = 0;
+   long ECount;
+   unsigned L1, L2;
+
+   // Argument #1
+   ParseArg(&Arg1, Arg1Type, Expr);
+   g_push(Arg1.Flags, Arg1.Expr.IVal);
+   GetCodePos(&Arg1.End);
+   ParamSize += SizeOf(Arg1Type);
+   ConsumeComma();
+
+   // Argument #2. Since strcat is a fastcall function, we must load the
+   // arg into the primary if it is not already there. This parameter is
+   // also ignored for the calculation of the parameter size, since it is
+   // not passed via the stack.
+   ParseArg(&Arg2, Arg2Type, Expr);
+   if (Arg2.Flags & CF_CONST) {
+      LoadExpr(CF_NONE, &Arg2.Expr);
+   }
+
+   // We still need to append deferred inc/dec before calling into the function
+   DoDeferred(SQP_KEEP_EAX, &Arg2.Expr);
+
+   // Emit the actual function call. This will also cleanup the stack.
+   g_call(CF_FIXARGC, Func_strcat, ParamSize);
+
+   // Get the element count of argument 1 if it is an array
+   ECount = ArrayElementCount(&Arg1);
+
+   // Inline the function if the destination is addressable with the Y
+   // register and known to be smaller than 256 bytes, the source has a
+   // constant address, and the code size factor allows 21 bytes of inline
+   // code instead of a call with about 14 bytes.
+   if (GetInlineStdFuncs() && IsIndexableAddr(&Arg1.Expr) &&
+       ED_IsConstAddr(&Arg2.Expr) &&
+       (IS_Get(&EagerlyInlineFuncs) ||
+        (ECount != UNSPECIFIED && ECount < 256)) &&
+       InlineSizeOk(21, 14)) {
+
+      // Drop the generated code
+      RemoveCode(&Arg1.Expr.Start);
+
+      // We need labels
+      L1 = GetLocalLabel();
+      L2 = GetLocalLabel();
+
+      // Generate strcat code: Find the end of the destination, then copy
+      // the source with X as index.
+      AddCodeLine("ldy #$FF");
+      g_defcodelabel(L1);
+      AddCodeLine("iny");
+      AddIndexedCodeLine("lda", &Arg1.Expr, 0);
+      AddCodeLine("bne %s", LocalLabelName(L1));
+      AddCodeLine("dey");
+      AddCodeLine("ldx #$FF");
+      g_defcodelabel(L2);
+      AddCodeLine("iny");
+      AddCodeLine("inx");
+      AddCodeLine("lda %s,x", ED_GetLabelName(&Arg2.Expr, 0));
+      AddIndexedCodeLine("sta", &Arg1.Expr, 0);
+      AddCodeLine("bne %s", LocalLabelName(L2));
+
+      // strcat returns argument #1
+      *Expr = Arg1.Expr;
+   }
+   else {
+      // The function result is an rvalue in the primary register
+      ED_FinalizeRValLoad(Expr);
+      Expr->Type = GetFuncReturnType(Expr->Type);
+   }
+
+   // We expect the closing brace
+   ConsumeRParen();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                  strchr
+////////////////////////////////////////////////////////////////////////////////
+
+static void StdFunc_strchr(FuncDesc *F attribute((unused)), ExprDesc *Expr)
+// Handle the strchr function
+{
+   // Argument types: (const char*, int)
+   static const Type *Arg1Type = type_c_char_p;
+   static const Type *Arg2Type = type_int;
+
+   ArgDesc Arg1, Arg2;
+   unsigned ParamSize = 0;
+   long ECount;
+   unsigned Loop, Found, Fin; // Labels
+
+   // Argument #1
+   ParseArg(&Arg1, Arg1Type, Expr);
+   g_push(Arg1.Flags, Arg1.Expr.IVal);
+   GetCodePos(&Arg1.End);
+   ParamSize += SizeOf(Arg1Type);
+   ConsumeComma();
+
+   // Argument #2. Since strchr is a fastcall function, we must load the
+   // arg into the primary if it is not already there. This parameter is
+   // also ignored for the calculation of the parameter size, since it is
+   // not passed via the stack.
+   ParseArg(&Arg2, Arg2Type, Expr);
+   if (Arg2.Flags & CF_CONST) {
+      LoadExpr(CF_NONE, &Arg2.Expr);
+   }
+
+   // We still need to append deferred inc/dec before calling into the function
+   DoDeferred(SQP_KEEP_EAX, &Arg2.Expr);
+
+   // Emit the actual function call. This will also cleanup the stack.
+   g_call(CF_FIXARGC, Func_strchr, ParamSize);
+
+   // Get the element count of argument 1 if it is an array
+   ECount = ArrayElementCount(&Arg1);
+
+   // Inline the function if the string is addressable with the Y register
+   // and known to be smaller than 256 bytes, the character is constant, and
+   // the code size factor allows 24 bytes of inline code instead of a call
+   // with about 14 bytes.
+   if (GetInlineStdFuncs() && IsIndexableAddr(&Arg1.Expr) &&
+       ED_IsConstAbsInt(&Arg2.Expr) &&
+       (IS_Get(&EagerlyInlineFuncs) ||
+        (ECount != UNSPECIFIED && ECount < 256)) &&
+       InlineSizeOk(24, 14)) {
+
+      // Drop the generated code
+      RemoveCode(&Arg1.Expr.Start);
+
+      // We need labels
+      Loop = GetLocalLabel();
+      Found = GetLocalLabel();
+      Fin = GetLocalLabel();
+
+      // Generate strchr code. The terminator is checked after the
+      // character, since it may be searched for.
+      AddCodeLine("ldy #$FF");
+      g_defcodelabel(Loop);
+      AddCodeLine("iny");
+      AddIndexedCodeLine("lda", &Arg1.Expr, 0);
+      AddCodeLine("cmp #$%02X", (unsigned char)Arg2.Expr.IVal);
+      AddCodeLine("beq %s", LocalLabelName(Found));
+      AddCodeLine("tax");
+      AddCodeLine("bne %s", LocalLabelName(Loop));
+      AddCodeLine("beq %s", LocalLabelName(Fin));
+      g_defcodelabel(Found);
+      AddAddrPlusY(&Arg1.Expr, Fin);
+      g_defcodelabel(Fin);
+   }
+
+   // The function result is an rvalue in the primary register
+   ED_FinalizeRValLoad(Expr);
+   Expr->Type = GetFuncReturnType(Expr->Type);
+
+   // We expect the closing brace
+   ConsumeRParen();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                  strcmp
 ////////////////////////////////////////////////////////////////////////////////
@@ -784,7 +1344,7 @@ static void StdFunc_strcmp(FuncDesc *F attribute((unused)), ExprDesc *Expr)
       ECount1 = ECount2;
    }
 
-   if (IS_Get(&InlineStdFuncs)) {
+   if (GetInlineStdFuncs()) {
 
       // If the second argument is the empty string literal, we can generate
       // more efficient code.
@@ -829,7 +1389,7 @@ static void StdFunc_strcmp(FuncDesc *F attribute((unused)), ExprDesc *Expr)
             g_getind(CF_CHAR | CF_UNSIGNED, 0);
          }
       }
-      else if ((IS_Get(&CodeSizeFactor) >= 165) &&
+      else if ((GetCodeSizeFactor() >= 165) &&
                (ED_IsConstAddr(&Arg2.Expr) || ED_IsZPInd(&Arg2.Expr)) &&
                (ED_IsConstAddr(&Arg1.Expr) || ED_IsZPInd(&Arg1.Expr)) &&
                (IS_Get(&EagerlyInlineFuncs) ||
@@ -876,7 +1436,7 @@ static void StdFunc_strcmp(FuncDesc *F attribute((unused)), ExprDesc *Expr)
          AddCodeLine("ldx #$FF");
          g_defcodelabel(Fin);
       }
-      else if ((IS_Get(&CodeSizeFactor) > 190) &&
+      else if ((GetCodeSizeFactor() > 190) &&
                (ED_IsConstAddr(&Arg2.Expr) || ED_IsZPInd(&Arg2.Expr)) &&
                (IS_Get(&EagerlyInlineFuncs) ||
                 (ECount1 > 0 && ECount1 < 256))) {
@@ -970,7 +1530,7 @@ static void StdFunc_strcpy(FuncDesc *F attribute((unused)), ExprDesc *Expr)
    // Get the element count of argument 1 if it is an array
    ECount = ArrayElementCount(&Arg1);
 
-   if (IS_Get(&InlineStdFuncs)) {
+   if (GetInlineStdFuncs()) {
 
       // We've generated the complete code for the function now and know the
       // types of all parameters. Check for situations where better code can
@@ -1192,7 +1752,7 @@ static void StdFunc_strlen(FuncDesc *F attribute((unused)), ExprDesc *Expr)
       }
    }
 
-   if (IS_Get(&InlineStdFuncs)) {
+   if (GetInlineStdFuncs()) {
 
       // We will inline strlen for arrays with constant addresses, if either
       // requested on the command line, or the array is smaller than 256,
@@ -1271,7 +1831,7 @@ static void StdFunc_strlen(FuncDesc *F attribute((unused)), ExprDesc *Expr)
       // Last check: We will inline a generic strlen routine if inlining was
       // requested on the command line, and the code size factor is more than
       // 400 (code is 13 bytes vs. 3 for a jsr call).
-      if (IS_Get(&CodeSizeFactor) > 400 && IS_Get(&EagerlyInlineFuncs)) {
+      if (GetCodeSizeFactor() > 400 && IS_Get(&EagerlyInlineFuncs)) {
 
          // Load the expression into the primary
          LoadExpr(CF_NONE, &Arg);
@@ -1315,6 +1875,210 @@ ExitPoint:
    Expr->Flags |= Arg.Flags & E_MASK_VIRAL;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//                        Precompiled printf formats
+////////////////////////////////////////////////////////////////////////////////
+
+static int CmpPrintfFunc(const void *Key, const void *Elem)
+// Compare function for bsearch
+{
+   return strcmp((const char *)Key,
+                 ((const struct PrintfFuncDesc *)Elem)->Name);
+}
+
+static void FlushPrintfRun(StrBuf *Desc, const char *Run, unsigned Len)
+// Append a run of literal characters to a format descriptor
+{
+   while (Len > 0) {
+      unsigned Count = (Len > PD_MAXRUN) ? PD_MAXRUN : Len;
+      SB_AppendChar(Desc, Count);
+      SB_AppendBuf(Desc, Run, Count);
+      Run += Count;
+      Len -= Count;
+   }
+}
+
+static int CompilePrintfFormat(StrBuf *Desc, const StrBuf *Fmt,
+                               const PrintfArgs *P)
+// Translate a printf format into a descriptor. Only formats with the flags
+// '-' and '0', a width and the conversions c, d, i, s, u, x and X are
+// accepted, and there must be exactly one matching argument for each
+// conversion. Return true if the format could be translated.
+{
+   const char *F = SB_GetConstBuf(Fmt);
+   unsigned Len = SB_GetLen(Fmt);
+   unsigned I = 0;
+   unsigned Run = 0;
+   unsigned Arg = 0;
+
+   // The literal is already translated into the target charset
+   char Percent = TgtTranslateChar('%');
+   char Zero = TgtTranslateChar('0');
+
+   SB_Clear(Desc);
+   while (I < Len && F[I] != '\0') {
+
+      unsigned Flags = 0;
+      unsigned Width = 0;
+      char Conv;
+
+      // Collect literal characters
+      if (F[I] != Percent) {
+         ++I;
+         ++Run;
+         continue;
+      }
+      if (I + 1 < Len && F[I + 1] == Percent) {
+         // Output the first '%' as part of the run and skip the second
+         FlushPrintfRun(Desc, F + I - Run, Run + 1);
+         I += 2;
+         Run = 0;
+         continue;
+      }
+      FlushPrintfRun(Desc, F + I - Run, Run);
+      Run = 0;
+      ++I;
+
+      // Flags
+      while (I < Len) {
+         if (F[I] == TgtTranslateChar('-')) {
+            Flags |= PD_LEFTJUST;
+         }
+         else if (F[I] == Zero) {
+            Flags |= PD_ZEROPAD;
+         }
+         else {
+            break;
+         }
+         ++I;
+      }
+
+      // Width
+      while (I < Len && F[I] >= Zero && F[I] <= Zero + 9) {
+         Width = Width * 10 + (F[I] - Zero);
+         if (Width > 0xFF) {
+            return 0;
+         }
+         ++I;
+      }
+
+      // Conversion. Check that there's an argument of the right class.
+      if (I >= Len || Arg >= P->ArgCount) {
+         return 0;
+      }
+      Conv = F[I++];
+      if (Conv == TgtTranslateChar('s')) {
+         if (P->ArgClass[Arg] != 'p') {
+            return 0;
+         }
+      }
+      else if (Conv == TgtTranslateChar('c') ||
+               Conv == TgtTranslateChar('d') ||
+               Conv == TgtTranslateChar('i') ||
+               Conv == TgtTranslateChar('u') ||
+               Conv == TgtTranslateChar('x') ||
+               Conv == TgtTranslateChar('X')) {
+         if (P->ArgClass[Arg] != 'i') {
+            return 0;
+         }
+      }
+      else {
+         return 0;
+      }
+      ++Arg;
+
+      SB_AppendChar(Desc, PD_CONV | Flags);
+      SB_AppendChar(Desc, Width);
+      SB_AppendChar(Desc, Conv);
+   }
+   FlushPrintfRun(Desc, F + I - Run, Run);
+   SB_AppendChar(Desc, PD_END);
+
+   // All arguments must have been used
+   return Arg == P->ArgCount;
+}
+
+void InitPrintfArgs(PrintfArgs *P, const char *Name, const FuncDesc *F)
+// Initialize the argument info for a call of the function with the given
+// name. If the function is one of the printf family that may use a
+// precompiled format, the format index is set, otherwise it is -1.
+{
+   const struct PrintfFuncDesc *D = 0;
+
+   P->FmtIndex = -1;
+   P->Fmt = 0;
+   P->ArgCount = 0;
+
+   // Precompiled formats are only used when inlining standard functions,
+   // and only for the prototypes from stdio.h
+   if (Name != 0 && GetInlineStdFuncs() && !IS_Get(&WritableStrings)) {
+      D = bsearch(Name, PrintfFuncs, PRINTF_FUNC_COUNT,
+                  sizeof(PrintfFuncs[0]), CmpPrintfFunc);
+   }
+   if (D != 0 && (F->Flags & FD_VARIADIC) != 0 &&
+       F->ParamCount == D->FmtIndex + 1) {
+      P->FmtIndex = D->FmtIndex;
+   }
+}
+
+void AddPrintfArg(PrintfArgs *P, unsigned Index, const ExprDesc *Expr)
+// Remember the argument with the given index of a printf like call
+{
+   if (P->FmtIndex < 0 || Index < (unsigned)P->FmtIndex) {
+      return;
+   }
+
+   if (Index == (unsigned)P->FmtIndex) {
+      // The format must be a string literal that isn't used otherwise
+      if (ED_IsLocLiteral(Expr) && Expr->IVal == 0 &&
+          IsClassPtr(Expr->Type) && IsRankChar(Indirect(Expr->Type))) {
+         P->Fmt = Expr->V.LVal;
+      }
+   }
+   else if (P->ArgCount < PRINTF_MAX_ARGS) {
+      char Class;
+      if (IsClassPtr(Expr->Type)) {
+         Class = 'p';
+      }
+      else if (IsClassInt(Expr->Type) && SizeOf(Expr->Type) == SIZEOF_INT) {
+         Class = 'i';
+      }
+      else {
+         Class = 'o';
+      }
+      P->ArgClass[P->ArgCount++] = Class;
+   }
+   else {
+      // Too many arguments, don't use a descriptor
+      P->Fmt = 0;
+   }
+}
+
+const char *GetPrintfFuncName(const char *Name, const PrintfArgs *P)
+// Return the name of the function to call for a printf like call. If the
+// format can be precompiled, the format literal is replaced by a descriptor
+// and the name of the function taking a descriptor is returned. Otherwise
+// Name is returned.
+{
+   const struct PrintfFuncDesc *D;
+   StrBuf Desc = AUTO_STRBUF_INITIALIZER;
+
+   if (P->FmtIndex < 0 || P->Fmt == 0 || ErrorCount > 0) {
+      return Name;
+   }
+
+   if (CompilePrintfFormat(&Desc, GetLiteralStrBuf(P->Fmt), P)) {
+      SetLiteralStrBuf(P->Fmt, &Desc);
+      D = bsearch(Name, PrintfFuncs, PRINTF_FUNC_COUNT,
+                  sizeof(PrintfFuncs[0]), CmpPrintfFunc);
+      CHECK(D != 0);
+      Name = D->DescName;
+   }
+   SB_Done(&Desc);
+
+   return Name;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                   Code
 ////////////////////////////////////////////////////////////////////////////////
@@ -36,8 +36,26 @@
 
 // cc65
 #include "expr.h"
+#include "litpool.h"
 #include "symtab.h"
 
+////////////////////////////////////////////////////////////////////////////////
+//                                    Data
+////////////////////////////////////////////////////////////////////////////////
+
+// Maximum number of variable arguments of a printf like call that may use
+// a precompiled format
+#define PRINTF_MAX_ARGS 16
+
+// Information about the arguments of a printf like call
+typedef struct PrintfArgs PrintfArgs;
+struct PrintfArgs {
+   int FmtIndex;                  // Index of the format or -1
+   Literal *Fmt;                  // Format string literal or NULL
+   unsigned ArgCount;             // Number of variable arguments
+   char ArgClass[PRINTF_MAX_ARGS]; // Class of each variable argument
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                   Code
 ////////////////////////////////////////////////////////////////////////////////
@@ -54,5 +72,19 @@ int FindStdFunc(const char *Name);
 void HandleStdFunc(int Index, struct FuncDesc *F, ExprDesc *lval);
 // Generate code for a known standard function.
 
+void InitPrintfArgs(PrintfArgs *P, const char *Name, const struct FuncDesc *F);
+// Initialize the argument info for a call of the function with the given
+// name. If the function is one of the printf family that may use a
+// precompiled format, the format index is set, otherwise it is -1.
+
+void AddPrintfArg(PrintfArgs *P, unsigned Index, const ExprDesc *Expr);
+// Remember the argument with the given index of a printf like call
+
+const char *GetPrintfFuncName(const char *Name, const PrintfArgs *P);
+// Return the name of the function to call for a printf like call. If the
+// format can be precompiled, the format literal is replaced by a descriptor
+// and the name of the function taking a descriptor is returned. Otherwise
+// Name is returned.
+
 // End of stdfunc.h
 #endif
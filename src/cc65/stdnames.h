@@ -39,8 +39,12 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 extern const char Func___bzero[]; // C name of "__bzero"
+extern const char Func_memchr[];  // C name of "memchr"
+extern const char Func_memcmp[];  // C name of "memcmp"
 extern const char Func_memcpy[];  // C name of "memcpy"
 extern const char Func_memset[];  // C name of "memset"
+extern const char Func_strcat[];  // C name of "strcat"
+extern const char Func_strchr[];  // C name of "strchr"
 extern const char Func_strcmp[];  // C name of "strcmp"
 extern const char Func_strcpy[];  // C name of "strcpy"
 extern const char Func_strlen[];  // C name of "strlen"
@@ -53,6 +53,7 @@
 #include "locals.h"
 #include "loop.h"
 #include "pragma.h"
+#include "profile.h"
 #include "scanner.h"
 #include "seqpoint.h"
 #include "stackptr.h"
@@ -623,6 +624,9 @@ int AnyStatement(int *PendingToken)
 // NULL, the function will skip the token.
 {
    int GotBreak = 0;
+   profheat_t Heat;
+   profheat_t OuterHeat = PH_NONE;
+   int SetHeat = 0;
 
    // Assume no pending token
    if (PendingToken) {
@@ -635,6 +639,18 @@ int AnyStatement(int *PendingToken)
       return 0;
    }
 
+   // If there is an execution profile, generate fast code for hot statements
+   // and small code for statements that were never executed. Other
+   // statements use the heat of the outer statement.
+   Heat = GetProfileHeat(CurTok.LI);
+   if (Heat != PH_NONE) {
+      F_AddHeat(CurrentFunc, Heat);
+   }
+   if (Heat == PH_HOT || Heat == PH_COLD) {
+      OuterHeat = SetStatementHeat(Heat);
+      SetHeat = 1;
+   }
+
    switch (CurTok.Tok) {
 
       case TOK_IF:
@@ -699,5 +715,10 @@ int AnyStatement(int *PendingToken)
    // Reset SQP flags
    SetSQPFlags(SQP_KEEP_NONE);
 
+   // Restore the heat of the outer statement
+   if (SetHeat) {
+      SetStatementHeat(OuterHeat);
+   }
+
    return GotBreak;
 }
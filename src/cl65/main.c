@@ -139,6 +139,39 @@ static int Module = 0;
 static char *TargetLib = 0;
 static int NoTargetLib = 0;
 
+// Maximum number of input files processed in parallel
+static unsigned MaxJobs = 1;
+
+// If true, the compiler output is passed to the assembler through a pipe
+static int UsePipe = 0;
+
+// The command that writes into the pipe to the assembler, if any
+static CmdDesc *PipeWriter = 0;
+
+// A job holds the commands for one input file. If several jobs may run in
+// parallel, the commands are recorded instead of being executed, and all jobs
+// are run by RunJobs() before linking.
+typedef struct Job Job;
+struct Job {
+   Job *Next;         // Next job in input file order
+   unsigned CmdCount; // Count of recorded commands
+   CmdDesc *Cmds;     // The recorded commands
+   CmdDesc TmpFiles;  // Intermediate files removed when the job ends
+   unsigned CurCmd;   // Index of the running command
+   int Pid;           // Process id of the running command
+   int Status;        // Return code of the job, negative for a signal
+   int Done;          // True if the job has ended
+   FILE *Out;         // Captured stdout of the running commands
+   FILE *Err;         // Captured stderr of the running commands
+   StrBuf OutText;    // Captured stdout of the ended job
+   StrBuf ErrText;    // Captured stderr of the ended job
+};
+
+// List of all jobs, and the job that records commands, if any
+static Job *FirstJob = 0;
+static Job *LastJob = 0;
+static Job *CurJob = 0;
+
 ////////////////////////////////////////////////////////////////////////////////
 //                Include the system specific spawn function
 ////////////////////////////////////////////////////////////////////////////////
@@ -327,6 +360,21 @@ static void CmdInit(CmdDesc *Cmd, const char *Path, const char *Name)
    xfree(FullName);
 }
 
+static void CmdCopy(CmdDesc *Dst, const CmdDesc *Src)
+// Copy the name and the arguments of a command
+{
+   unsigned I;
+
+   Dst->Name = xstrdup(Src->Name);
+   Dst->ArgCount = Dst->ArgMax = Src->ArgCount;
+   Dst->Args = xmalloc(Src->ArgCount * sizeof(char *));
+   for (I = 0; I < Src->ArgCount; ++I) {
+      Dst->Args[I] = Src->Args[I] ? xstrdup(Src->Args[I]) : 0;
+   }
+   Dst->FileCount = Dst->FileMax = 0;
+   Dst->Files = 0;
+}
+
 static void CmdSetOutput(CmdDesc *Cmd, const char *File)
 // Set the output file in a command desc
 {
@@ -375,11 +423,52 @@ static void SetTargetFiles(void)
 //                               Subprocesses
 ////////////////////////////////////////////////////////////////////////////////
 
+static Job *NewJob(void)
+// Create a new job and append it to the list of jobs
+{
+   Job *J = xmalloc(sizeof(Job));
+
+   J->Next = 0;
+   J->CmdCount = 0;
+   J->Cmds = 0;
+   memset(&J->TmpFiles, 0, sizeof(J->TmpFiles));
+   J->CurCmd = 0;
+   J->Pid = -1;
+   J->Status = 0;
+   J->Done = 0;
+   J->Out = 0;
+   J->Err = 0;
+   SB_Init(&J->OutText);
+   SB_Init(&J->ErrText);
+
+   if (LastJob) {
+      LastJob->Next = J;
+   }
+   else {
+      FirstJob = J;
+   }
+   LastJob = J;
+   return J;
+}
+
+static void JobAddCmd(Job *J, const CmdDesc *Cmd)
+// Record a command for a job
+{
+   J->Cmds = xrealloc(J->Cmds, (J->CmdCount + 1) * sizeof(CmdDesc));
+   CmdCopy(&J->Cmds[J->CmdCount++], Cmd);
+}
+
 static void ExecProgram(CmdDesc *Cmd)
 // Execute a subprocess with the given name/parameters. Exit on errors.
 {
    int Status;
 
+   // If the commands are recorded for a job, it is run later
+   if (CurJob) {
+      JobAddCmd(CurJob, Cmd);
+      return;
+   }
+
    // If in debug mode, output the command line we will execute
    if (Debug) {
       printf("Executing: ");
@@ -401,17 +490,200 @@ static void ExecProgram(CmdDesc *Cmd)
    }
 }
 
+#if defined(HAVE_PIPE)
+
+static void ExecPipe(CmdDesc *Writer, CmdDesc *Reader, const char *Pipe)
+// Execute two subprocesses connected by a named pipe. Exit on errors.
+{
+   int Status;
+
+   // If in debug mode, output the command lines we will execute
+   if (Debug) {
+      printf("Executing: ");
+      CmdPrint(Writer, stdout);
+      printf("\nExecuting: ");
+      CmdPrint(Reader, stdout);
+      printf("\n");
+   }
+
+   // The pipe must be removed even if one of the programs fails
+   CmdAddFile(&RM, Pipe);
+
+   // Call the programs
+   Status = spawnvp_pipe(Writer->Name, Writer->Args, Reader->Name,
+                         Reader->Args, Pipe);
+
+   // Check the result code
+   if (Status != 0) {
+      exit(Status);
+   }
+}
+
+#endif
+
 static void RemoveTempFiles(void) {
    unsigned I;
 
+   // Files of failed or never started jobs may not exist
    for (I = 0; I < RM.FileCount; ++I) {
-      if (remove(RM.Files[I]) < 0) {
+      if (remove(RM.Files[I]) < 0 && errno != ENOENT) {
          Warning("Cannot remove temporary file '%s': %s", RM.Files[I],
                  strerror(errno));
       }
    }
 }
 
+#if defined(HAVE_JOBS)
+
+static void JobStartCmd(Job *J)
+// Start the current command of a job
+{
+   CmdDesc *Cmd = &J->Cmds[J->CurCmd];
+
+   // If in debug mode, output the command line we will execute
+   if (Debug) {
+      fprintf(J->Out, "Executing: ");
+      CmdPrint(Cmd, J->Out);
+      fprintf(J->Out, "\n");
+      fflush(J->Out);
+   }
+
+   J->Pid = spawnvp_nowait(Cmd->Name, Cmd->Args, fileno(J->Out),
+                           fileno(J->Err));
+}
+
+static void JobStart(Job *J)
+// Start the first command of a job. The output is captured in temporary
+// files, so it can be printed in input file order.
+{
+   if ((J->Out = tmpfile()) == 0 || (J->Err = tmpfile()) == 0) {
+      Error("Cannot create temporary file: %s", strerror(errno));
+   }
+   JobStartCmd(J);
+}
+
+static void ReadOutput(FILE **From, StrBuf *To)
+// Read the captured output of a job into memory and close the capture file
+{
+   char Buf[4096];
+   size_t Count;
+
+   if (*From) {
+      rewind(*From);
+      while ((Count = fread(Buf, 1, sizeof(Buf), *From)) > 0) {
+         SB_AppendBuf(To, Buf, Count);
+      }
+      fclose(*From);
+      *From = 0;
+   }
+}
+
+static void PrintOutput(StrBuf *From, FILE *To)
+// Print the captured output of a job and free it
+{
+   if (SB_GetLen(From) > 0) {
+      fwrite(SB_GetConstBuf(From), 1, SB_GetLen(From), To);
+      fflush(To);
+   }
+   SB_Done(From);
+}
+
+static void JobEnd(Job *J, int Status)
+// Mark a job as ended and remove its intermediate files. The output is kept
+// in memory until it is printed, so only running jobs have open files.
+{
+   unsigned I;
+
+   J->Status = Status;
+   J->Done = 1;
+   ReadOutput(&J->Out, &J->OutText);
+   ReadOutput(&J->Err, &J->ErrText);
+   for (I = 0; I < J->TmpFiles.FileCount; ++I) {
+      if (remove(J->TmpFiles.Files[I]) < 0 && errno != ENOENT) {
+         Warning("Cannot remove temporary file '%s': %s",
+                 J->TmpFiles.Files[I], strerror(errno));
+      }
+   }
+}
+
+static void RunJobs(void)
+// Run the recorded jobs, at most MaxJobs of them in parallel. The output of
+// the jobs is printed in input file order. If a job fails or is aborted by a
+// signal, no new jobs are started, and the failure of the first failed job in
+// input file order is reported after the running jobs have ended.
+{
+   Job *Next = FirstJob;  // Next job to start
+   Job *Print = FirstJob; // Next job to print
+   unsigned Running = 0;
+   int Failed = 0;
+   Job *J;
+
+   while (1) {
+
+      int Pid;
+      int Status;
+
+      // Start new jobs while there are free slots
+      while (Next && Running < MaxJobs && !Failed) {
+         if (Next->CmdCount == 0) {
+            JobEnd(Next, 0);
+         }
+         else {
+            JobStart(Next);
+            ++Running;
+         }
+         Next = Next->Next;
+      }
+
+      // Print the output of the ended jobs in order
+      while (Print && Print->Done) {
+         PrintOutput(&Print->OutText, stdout);
+         PrintOutput(&Print->ErrText, stderr);
+         Print = Print->Next;
+      }
+
+      // Done if nothing is running
+      if (Running == 0) {
+         break;
+      }
+
+      // Wait for a command to end and find its job
+      Pid = waitchild(&Status);
+      for (J = Print; J != Next && J->Pid != Pid; J = J->Next) {
+      }
+      if (J == Next) {
+         continue;
+      }
+      J->Pid = -1;
+
+      // Start the next command of the job, or end it
+      if (Status == 0 && ++J->CurCmd < J->CmdCount) {
+         JobStartCmd(J);
+      }
+      else {
+         JobEnd(J, Status);
+         --Running;
+         if (Status != 0) {
+            Failed = 1;
+         }
+      }
+   }
+
+   // Report the first failed job. A job that failed stopped at the command
+   // that failed.
+   for (J = FirstJob; J; J = J->Next) {
+      if (J->Status < 0) {
+         Error("Subprocess '%s' aborted by signal %d", J->Cmds[J->CurCmd].Name,
+               -J->Status);
+      }
+      else if (J->Status != 0) {
+         exit(J->Status);
+      }
+   }
+}
+
+#endif
+
 static void Link(void)
 // Link the resulting executable
 {
@@ -516,8 +788,17 @@ static void AssembleFile(const char *File, const char *TmpFile,
    // Add a NULL pointer to terminate the argument list
    CmdAddArg(&CA65, 0);
 
-   // Run the assembler
-   ExecProgram(&CA65);
+   // Run the assembler. If the input comes from the compiler through a
+   // pipe, run both together.
+#if defined(HAVE_PIPE)
+   if (PipeWriter) {
+      ExecPipe(PipeWriter, &CA65, TmpFile);
+   }
+   else
+#endif
+   {
+      ExecProgram(&CA65);
+   }
 
    // Remove the excess arguments
    CmdDelArgs(&CA65, ArgCount);
@@ -536,8 +817,12 @@ static void AssembleIntermediate(const char *SourceFile, const char *TmpFile)
    // Assemble the intermediate assembler file
    AssembleFile(AsmName, AsmTmpName, CA65.ArgCount);
 
-   // Remove the input file
-   if (remove(AsmTmpName ? AsmTmpName : AsmName) < 0) {
+   // Remove the input file. If the commands are recorded for a job, the
+   // file is removed when the job ends.
+   if (CurJob) {
+      CmdAddFile(&CurJob->TmpFiles, AsmTmpName ? AsmTmpName : AsmName);
+   }
+   else if (remove(AsmTmpName ? AsmTmpName : AsmName) < 0) {
       Warning("Cannot remove temporary file '%s': %s",
               AsmTmpName ? AsmTmpName : AsmName, strerror(errno));
    }
@@ -619,11 +904,15 @@ static void Compile(const char *File)
    // Add a NULL pointer to terminate the argument list
    CmdAddArg(&CC65, 0);
 
-   // Run the compiler
-   ExecProgram(&CC65);
-
-   // Remove the excess arguments
-   CmdDelArgs(&CC65, ArgCount);
+   // Run the compiler. If its output is passed through a pipe, it is run
+   // together with the assembler. Pipes aren't used for parallel jobs.
+   if (UsePipe && DoAssemble && !CurJob) {
+      PipeWriter = &CC65;
+   }
+   else {
+      ExecProgram(&CC65);
+      CmdDelArgs(&CC65, ArgCount);
+   }
 
    // If this is not the final step, assemble the generated file, then
    // remove it
@@ -634,6 +923,12 @@ static void Compile(const char *File)
          xfree(TmpFile);
       }
    }
+
+   // Remove the excess arguments of a compiler run through a pipe
+   if (PipeWriter) {
+      PipeWriter = 0;
+      CmdDelArgs(&CC65, ArgCount);
+   }
 }
 
 static void CompileRes(const char *File)
@@ -781,6 +1076,7 @@ static void Usage(void)
        "  --force-import sym\t\tForce an import of symbol 'sym'\n"
        "  --help\t\t\tHelp (this text)\n"
        "  --include-dir dir\t\tSet a compiler include directory path\n"
+       "  --jobs n\t\t\tProcess up to n input files in parallel\n"
        "  --ld-args options\t\tPass options to the linker\n"
        "  --lib-path path\t\tSpecify a library search path\n"
        "  --list-targets\t\tList all available targets\n"
@@ -794,7 +1090,9 @@ static void Usage(void)
        "  --o65-model model\t\tOverride the o65 model\n"
        "  --obj file\t\t\tLink this object file\n"
        "  --obj-path path\t\tSpecify an object file search path\n"
+       "  --pipe\t\t\tPass compiler output to the assembler in a pipe\n"
        "  --print-target-path\t\tPrint the target file path\n"
+       "  --profile-use file\t\tOptimize using an execution profile\n"
        "  --register-space b\t\tSet space available for register variables\n"
        "  --register-vars\t\tEnable register variables\n"
        "  --rodata-name seg\t\tSet the name of the RODATA segment\n"
@@ -996,6 +1294,20 @@ static void OptIncludeDir(const char *Opt attribute((unused)), const char *Arg)
    CmdAddArg2(&CC65, "-I", Arg);
 }
 
+static void OptJobs(const char *Opt, const char *Arg)
+// Handle the --jobs option
+{
+   if (sscanf(Arg, "%u", &MaxJobs) != 1 || MaxJobs == 0) {
+      Error("Invalid argument for %s: '%s'", Opt, Arg);
+   }
+#if !defined(HAVE_JOBS)
+   if (MaxJobs > 1) {
+      Warning("Parallel jobs are not supported on this system");
+      MaxJobs = 1;
+   }
+#endif
+}
+
 static void OptLdArgs(const char *Opt attribute((unused)), const char *Arg)
 // Pass arguments to the linker
 {
@@ -1097,6 +1409,17 @@ static void OptObjPath(const char *Opt attribute((unused)), const char *Arg)
    CmdAddArg2(&LD65, "--obj-path", Arg);
 }
 
+static void OptPipe(const char *Opt attribute((unused)),
+                    const char *Arg attribute((unused)))
+// Handle the --pipe option
+{
+#if defined(HAVE_PIPE)
+   UsePipe = 1;
+#else
+   Warning("Pipes are not supported on this system");
+#endif
+}
+
 static void OptPrintTargetPath(const char *Opt attribute((unused)),
                                const char *Arg attribute((unused)))
 // Print the target file path
@@ -1132,6 +1455,12 @@ static void OptPrintTargetPath(const char *Opt attribute((unused)),
    exit(EXIT_SUCCESS);
 }
 
+static void OptProfileUse(const char *Opt attribute((unused)), const char *Arg)
+// Handle the --profile-use option
+{
+   CmdAddArg2(&CC65, "--profile-use", Arg);
+}
+
 static void OptRegisterSpace(const char *Opt attribute((unused)),
                              const char *Arg)
 // Handle the --register-space option
@@ -1256,6 +1585,7 @@ int main(int argc, char *argv[])
        {"--force-import", 1, OptForceImport},
        {"--help", 0, OptHelp},
        {"--include-dir", 1, OptIncludeDir},
+       {"--jobs", 1, OptJobs},
        {"--ld-args", 1, OptLdArgs},
        {"--lib-path", 1, OptLibPath},
        {"--list-targets", 0, OptListTargets},
@@ -1269,7 +1599,9 @@ int main(int argc, char *argv[])
        {"--o65-model", 1, OptO65Model},
        {"--obj", 1, OptObj},
        {"--obj-path", 1, OptObjPath},
+       {"--pipe", 0, OptPipe},
        {"--print-target-path", 0, OptPrintTargetPath},
+       {"--profile-use", 1, OptProfileUse},
        {"--register-space", 1, OptRegisterSpace},
        {"--register-vars", 0, OptRegisterVars},
        {"--rodata-name", 1, OptRodataName},
@@ -1290,6 +1622,10 @@ int main(int argc, char *argv[])
    // Initialize the cmdline module
    InitCmdLine(&argc, &argv, "cl65");
 
+   // Compiling, assembling or linking may not return if there's an error,
+   // so we install RemoveTempFiles() as an atexit() handler.
+   atexit(RemoveTempFiles);
+
    // Initialize the command descriptors
    if (argc == 0) {
       CmdPath = xstrdup("");
@@ -1495,6 +1831,12 @@ int main(int argc, char *argv[])
             FirstInput = Arg;
          }
 
+         // If files are processed in parallel, record the commands for this
+         // file in a job
+         if (MaxJobs > 1) {
+            CurJob = NewJob();
+         }
+
          // Determine the file type by the extension
          switch (GetTypeOfFile(Arg)) {
 
@@ -1529,12 +1871,20 @@ int main(int argc, char *argv[])
             default:
                Error("Don't know what to do with '%s'", Arg);
          }
+         CurJob = 0;
       }
 
       // Next argument
       ++I;
    }
 
+#if defined(HAVE_JOBS)
+   // Run the recorded jobs
+   if (FirstJob) {
+      RunJobs();
+   }
+#endif
+
    // Check if we had any input files
    if (FirstInput == 0) {
       Warning("No input files");
@@ -1542,10 +1892,6 @@ int main(int argc, char *argv[])
 
    // Link the given files if requested and if we have any
    if (DoLink && LD65.FileCount > 0) {
-      //
-      // Link() may not return if there's an error, so we install
-      // RemoveTempFiles() as an atexit() handler.
-      atexit(RemoveTempFiles);
       Link();
    }
 
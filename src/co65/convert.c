@@ -49,6 +49,13 @@
 #include "o65.h"
 #include "convert.h"
 
+////////////////////////////////////////////////////////////////////////////////
+//                                   Data
+////////////////////////////////////////////////////////////////////////////////
+
+// Maximum number of bytes output in one .byte line
+#define BYTES_PER_LINE 16
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                   Code
 ////////////////////////////////////////////////////////////////////////////////
@@ -81,25 +88,25 @@ static void SetupSegLabels(FILE *F)
       fprintf(F, ".export\t\t%s\n", BssLabel);
    }
    else {
-      BssLabel = xstrdup("BSS");
+      BssLabel = "BSS";
    }
    if (CodeLabel) {
       fprintf(F, ".export\t\t%s\n", CodeLabel);
    }
    else {
-      CodeLabel = xstrdup("CODE");
+      CodeLabel = "CODE";
    }
    if (DataLabel) {
       fprintf(F, ".export\t\t%s\n", DataLabel);
    }
    else {
-      DataLabel = xstrdup("DATA");
+      DataLabel = "DATA";
    }
    if (ZeropageLabel) {
       fprintf(F, ".export\t\t%s\n", ZeropageLabel);
    }
    else {
-      ZeropageLabel = xstrdup("ZEROPAGE");
+      ZeropageLabel = "ZEROPAGE";
    }
 }
 
@@ -198,16 +205,44 @@ static void ConvertExports(FILE *F, const O65Data *D)
    }
 }
 
+static void ConvertBytes(FILE *F, const unsigned char *Data, unsigned long Size)
+// Output bytes without relocation as .byte lines with up to BYTES_PER_LINE
+// values each
+{
+   static const char HexTab[] = "0123456789ABCDEF";
+   char Buf[sizeof("\t.byte\t") + BYTES_PER_LINE * 4];
+
+   while (Size > 0) {
+
+      unsigned Count = (Size < BYTES_PER_LINE) ? Size : BYTES_PER_LINE;
+      char *P = Buf + sizeof("\t.byte\t") - 1;
+      unsigned I;
+
+      // Format the line in the buffer and write it in one go
+      memcpy(Buf, "\t.byte\t", sizeof("\t.byte\t") - 1);
+      for (I = 0; I < Count; ++I) {
+         *P++ = '$';
+         *P++ = HexTab[Data[I] >> 4];
+         *P++ = HexTab[Data[I] & 0x0F];
+         *P++ = ',';
+      }
+      P[-1] = '\n';
+      fwrite(Buf, 1, P - Buf, F);
+
+      Data += Count;
+      Size -= Count;
+   }
+}
+
 static void ConvertSeg(FILE *F, const O65Data *D, const Collection *Relocs,
                        const unsigned char *Data, unsigned long Size)
-// Convert one segment
+// Convert one segment. The relocation entries are sorted by offset, so the
+// segment data and the relocation list are merged in one pass.
 {
    const O65Reloc *R;
    unsigned RIdx;
    unsigned long Byte;
-
-   // Get the pointer to the first relocation entry if there are any
-   R = (CollCount(Relocs) > 0) ? CollConstAt(Relocs, 0) : 0;
+   unsigned long End;
 
    // Initialize for the loop
    RIdx = 0;
@@ -216,7 +251,19 @@ static void ConvertSeg(FILE *F, const O65Data *D, const Collection *Relocs,
    // Walk over the segment data
    while (Byte < Size) {
 
-      if (R && R->Offs == Byte) {
+      // Get the next relocation entry if there is one
+      R = (RIdx < CollCount(Relocs)) ? CollConstAt(Relocs, RIdx) : 0;
+      if (R && R->Offs < Byte) {
+         Error("Overlapping relocation at %lu (input file corrupt)", R->Offs);
+      }
+
+      // Output the bytes up to the relocation entry as they are
+      End = (R && R->Offs < Size) ? R->Offs : Size;
+      if (Byte < End) {
+         ConvertBytes(F, Data + Byte, End - Byte);
+         Byte = End;
+      }
+      else {
          // We've reached an entry that must be relocated
          unsigned long Val;
          switch (R->Type) {
@@ -263,17 +310,8 @@ static void ConvertSeg(FILE *F, const O65Data *D, const Collection *Relocs,
                         Byte);
          }
 
-         // Get the next relocation entry
-         if (++RIdx < CollCount(Relocs)) {
-            R = CollConstAt(Relocs, RIdx);
-         }
-         else {
-            R = 0;
-         }
-      }
-      else {
-         // Just a constant value
-         fprintf(F, "\t.byte\t$%02X\n", Data[Byte++]);
+         // Continue with the next relocation entry
+         ++RIdx;
       }
    }
 
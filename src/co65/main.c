@@ -40,6 +40,7 @@
 // common
 #include "chartype.h"
 #include "cmdline.h"
+#include "coll.h"
 #include "debugflag.h"
 #include "fname.h"
 #include "print.h"
@@ -63,7 +64,7 @@ static void Usage(void)
 // Print usage information and exit
 {
    printf(
-       "Usage: %s [options] file\n"
+       "Usage: %s [options] file ...\n"
        "Short options:\n"
        "  -V\t\t\tPrint the version number\n"
        "  -g\t\t\tAdd debug info to object file\n"
@@ -254,17 +255,44 @@ static void OptZeropageName(const char *Opt attribute((unused)),
    ZeropageSeg = xstrdup(Arg);
 }
 
-static void DoConversion(void)
-// Do file conversion
+static void DoConversion(const char *Name, const char *Output)
+// Convert the file Name. If Output is NULL, the name of the output file is
+// generated from the name of the input file.
 {
+   O65Data *D;
+   char *DefaultOutput = 0;
+
+   // Converting a file may change the model and the segment labels. Remember
+   // the settings from the command line, so they are used for all files.
+   O65Model SavedModel = Model;
+   const char *SavedCodeLabel = CodeLabel;
+   const char *SavedDataLabel = DataLabel;
+   const char *SavedBssLabel = BssLabel;
+   const char *SavedZeropageLabel = ZeropageLabel;
+
+   // Set the file names
+   InputName = Name;
+   if (Output == 0) {
+      Output = DefaultOutput = MakeFilename(Name, AsmExt);
+   }
+   OutputName = Output;
+
    // Read the o65 file into memory
-   O65Data *D = ReadO65File(InputName);
+   D = ReadO65File(InputName);
 
    // Do the conversion
    Convert(D);
 
    // Free the o65 module data
-   // ###
+   FreeO65Data(D);
+   xfree(DefaultOutput);
+
+   // Restore the settings
+   Model = SavedModel;
+   CodeLabel = SavedCodeLabel;
+   DataLabel = SavedDataLabel;
+   BssLabel = SavedBssLabel;
+   ZeropageLabel = SavedZeropageLabel;
 }
 
 int main(int argc, char *argv[])
@@ -289,6 +317,10 @@ int main(int argc, char *argv[])
        {"--zeropage-name", 1, OptZeropageName},
    };
 
+   // Input files and the name of the output file
+   Collection InputFiles = AUTO_COLLECTION_INITIALIZER;
+   const char *Output = 0;
+
    unsigned I;
 
    // Initialize the cmdline module
@@ -326,7 +358,7 @@ int main(int argc, char *argv[])
                break;
 
             case 'o':
-               OutputName = GetArg(&I, 2);
+               Output = GetArg(&I, 2);
                break;
 
             case 'v':
@@ -343,13 +375,8 @@ int main(int argc, char *argv[])
          }
       }
       else {
-         // Filename. Check if we already had one
-         if (InputName) {
-            Error("Don't know what to do with '%s'", Arg);
-         }
-         else {
-            InputName = Arg;
-         }
+         // Filename. Several files may be converted in one run.
+         CollAppend(&InputFiles, (void *)Arg);
       }
 
       // Next argument
@@ -357,17 +384,20 @@ int main(int argc, char *argv[])
    }
 
    // Do we have an input file?
-   if (InputName == 0) {
+   if (CollCount(&InputFiles) == 0) {
       Error("No input file");
    }
 
-   // Generate the name of the output file if none was specified
-   if (OutputName == 0) {
-      OutputName = MakeFilename(InputName, AsmExt);
+   // The output file can only be named if there's one input file
+   if (Output && CollCount(&InputFiles) > 1) {
+      Error("Cannot use -o with more than one input file");
    }
 
-   // Do the conversion
-   DoConversion();
+   // Convert the files
+   for (I = 0; I < CollCount(&InputFiles); ++I) {
+      DoConversion(CollAtUnchecked(&InputFiles, I), Output);
+   }
+   DoneCollection(&InputFiles);
 
    // Return an apropriate exit code
    return EXIT_SUCCESS;
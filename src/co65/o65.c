@@ -67,6 +67,29 @@ static O65Data *NewO65Data(void)
    return D;
 }
 
+static void FreeItems(Collection *C)
+// Free all items of a collection and the collection data
+{
+   unsigned I;
+   for (I = 0; I < CollCount(C); ++I) {
+      xfree(CollAtUnchecked(C, I));
+   }
+   DoneCollection(C);
+}
+
+void FreeO65Data(O65Data *D)
+// Free an O65Data struct returned by ReadO65File
+{
+   FreeItems(&D->Options);
+   xfree(D->Text);
+   xfree(D->Data);
+   FreeItems(&D->TextReloc);
+   FreeItems(&D->DataReloc);
+   FreeItems(&D->Imports);
+   FreeItems(&D->Exports);
+   xfree(D);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                   Code
 ////////////////////////////////////////////////////////////////////////////////
@@ -197,6 +197,9 @@ O65Data *ReadO65File(const char *Name);
 // Read a complete o65 file into dynamically allocated memory and return the
 // created O65Data struct.
 
+void FreeO65Data(O65Data *D);
+// Free an O65Data struct returned by ReadO65File
+
 const char *GetO65OSName(unsigned char OS);
 // Return the name of the operating system given by OS
 
@@ -40,7 +40,11 @@
 
 // Defines for magic and version
 #define LIB_MAGIC 0x7A55616E
-#define LIB_VERSION 0x000D
+#define LIB_VERSION 0x000E
+
+// Previous version without export names in the index. It is still accepted
+// when reading libraries.
+#define LIB_VERSION_NOEXPORTS 0x000D
 
 // Size of an library file header
 #define LIB_HDR_SIZE 12
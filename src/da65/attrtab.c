@@ -32,6 +32,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <inttypes.h>
+#include <string.h>
 
 // common
 #include "xmalloc.h"
@@ -45,66 +46,14 @@
 //                                   Data
 ////////////////////////////////////////////////////////////////////////////////
 
-// Attribute structure how it is found in the attribute table
-typedef struct Attribute Attribute;
-struct Attribute {
-   struct Attribute *Next; // Next entry in linked list
-   uint32_t Addr;          // The full address
-   attr_t Attr;            // Actual attribute
-};
-
-// Attributes use a hash table and a linear list for collision resolution. The
-// hash function is easy and effective. It evaluates just the lower bits of
-// the address.
-#define ATTR_HASH_SIZE 8192u // Must be power of two
-static Attribute *AttributeTab[ATTR_HASH_SIZE];
-
-////////////////////////////////////////////////////////////////////////////////
-//                             struct Attribute
-////////////////////////////////////////////////////////////////////////////////
-
-static Attribute *NewAttribute(uint32_t Addr, attr_t Attr)
-// Create a new attribute structure and return it
-{
-   // Create a new attribute
-   Attribute *A = xmalloc(sizeof(Attribute));
-
-   // Fill in the data
-   A->Next = 0;
-   A->Addr = Addr;
-   A->Attr = Attr;
-
-   // Return the attribute just created
-   return A;
-}
-
-static uint32_t GetAttributeHash(uint32_t Addr)
-// Get the hash for an attribute at the given address
-{
-   return (Addr & (ATTR_HASH_SIZE - 1));
-}
-
-static Attribute *FindAttribute(uint32_t Addr)
-// Search for an attribute for the given address and return it. Returns NULL
-// if no attribute exists for the address.
-{
-   Attribute *A = AttributeTab[GetAttributeHash(Addr)];
-   while (A) {
-      if (A->Addr == Addr) {
-         break;
-      }
-      A = A->Next;
-   }
-   return A;
-}
-
-static void InsertAttribute(Attribute *A)
-// Insert an attribute into the hash table
-{
-   uint32_t Hash = GetAttributeHash(A->Addr);
-   A->Next = AttributeTab[Hash];
-   AttributeTab[Hash] = A;
-}
+// Attributes are stored in dense pages of 256 addresses, which are allocated
+// when the first attribute in the page is set. Small pages keep the memory
+// use low if there are labels all over the 24-bit address space of the 65816.
+// An address without an attribute has the attribute atDefault, so a missing
+// page reads as all zero. All attribute flags fit into 16 bits.
+#define ATTR_PAGE_SIZE 0x100u
+#define ATTR_PAGE_COUNT 0x10000u // Pages for the 24-bit address space
+static uint16_t *AttributeTab[ATTR_PAGE_COUNT];
 
 ////////////////////////////////////////////////////////////////////////////////
 //                                   Code
@@ -113,7 +62,8 @@ static void InsertAttribute(Attribute *A)
 void AddrCheck(uint32_t Addr)
 // Check if the given address has a valid range
 {
-   if (Addr >= 0x10000 && CPU != CPU_65816) {
+   if (Addr >= ATTR_PAGE_SIZE * ATTR_PAGE_COUNT ||
+       (Addr >= 0x10000 && CPU != CPU_65816)) {
       Error("Address out of range: $%04" PRIX32, Addr);
    }
 }
@@ -121,20 +71,14 @@ void AddrCheck(uint32_t Addr)
 attr_t GetAttr(uint32_t Addr)
 // Return the attribute for the given address
 {
-   // As a small optimization we cache the last used attribute so when the
-   // function is called several times with the same address we do already
-   // know it.
-   static const Attribute *A = 0;
-   if (A != 0 && A->Addr == Addr) {
-      return A->Attr;
-   }
+   const uint16_t *Page;
 
    // Check the given address
    AddrCheck(Addr);
 
    // Return the attribute
-   A = FindAttribute(Addr);
-   return A ? A->Attr : atDefault;
+   Page = AttributeTab[Addr / ATTR_PAGE_SIZE];
+   return Page ? (attr_t)Page[Addr % ATTR_PAGE_SIZE] : atDefault;
 }
 
 int SegmentDefined(uint32_t Start, uint32_t End)
@@ -204,26 +148,28 @@ void MarkRange(uint32_t Start, uint32_t End, attr_t Attr)
 void MarkAddr(uint32_t Addr, attr_t Attr)
 // Mark an address with an attribute
 {
+   uint16_t *Page;
+   uint16_t *A;
+
    // Check the given address
    AddrCheck(Addr);
 
-   // Get an existing attribute entry
-   Attribute *A = FindAttribute(Addr);
+   // Get the page of the address, allocating it if needed
+   Page = AttributeTab[Addr / ATTR_PAGE_SIZE];
+   if (Page == 0) {
+      Page = xmalloc(ATTR_PAGE_SIZE * sizeof(Page[0]));
+      memset(Page, 0, ATTR_PAGE_SIZE * sizeof(Page[0]));
+      AttributeTab[Addr / ATTR_PAGE_SIZE] = Page;
+   }
+   A = &Page[Addr % ATTR_PAGE_SIZE];
 
    // We must not have more than one style bit
-   if (A != 0 && (Attr & atStyleMask) != 0) {
-      if ((A->Attr & atStyleMask) != 0) {
-         Error("Duplicate style for address %04" PRIX32, Addr);
-      }
+   if ((Attr & atStyleMask) != 0 && (*A & atStyleMask) != 0) {
+      Error("Duplicate style for address %04" PRIX32, Addr);
    }
 
    // Set the style
-   if (A) {
-      A->Attr |= Attr;
-   }
-   else {
-      InsertAttribute(NewAttribute(Addr, Attr));
-   }
+   *A |= Attr;
 }
 
 attr_t GetStyleAttr(uint32_t Addr)
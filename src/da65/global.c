@@ -55,6 +55,7 @@ signed char NewlineAfterRTS = -1; // Add a newline after a RTS insn?
 unsigned char HaveStartAddr = 0;  // Flag for start address given
 uint32_t StartAddr = 0;           // Start/load address of the program
 unsigned char SyncLines = 0;      // Accept line markers in the info file
+unsigned char TraceCode = 0;      // Trace the code flow from entry points
 long InputOffs = -1L;             // Offset into input file
 long InputSize = -1L;             // Number of bytes to read from input
 
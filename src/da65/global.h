@@ -58,6 +58,7 @@ extern signed char NewlineAfterRTS; // Add a newline after a RTS insn?
 extern unsigned char HaveStartAddr; // Flag for start address given
 extern uint32_t StartAddr;          // Start/load address of the program
 extern unsigned char SyncLines;     // Accept line markers in the info file
+extern unsigned char TraceCode;     // Trace the code flow from entry points
 extern long InputOffs;              // Offset into input file
 extern long InputSize;              // Number of bytes to read from input
 
@@ -852,3 +852,7 @@ void OH_JsrAbsolute(const OpcDesc *D) {
 void SetSubroutineParamSize(uint32_t Addr, unsigned Size) {
    SubroutineParamSize[Addr] = Size;
 }
+
+unsigned GetSubroutineParamSize(uint32_t Addr) {
+   return SubroutineParamSize[Addr];
+}
@@ -115,6 +115,8 @@ void OH_JsrAbsolute(const OpcDesc *);
 
 void SetSubroutineParamSize(uint32_t Addr, unsigned Size);
 
+unsigned GetSubroutineParamSize(uint32_t Addr);
+
 // End of handler.h
 
 #endif
@@ -63,6 +63,7 @@
 #include "output.h"
 #include "scanner.h"
 #include "segment.h"
+#include "trace.h"
 
 static unsigned PrevAddrMode;
 
@@ -105,6 +106,7 @@ static void Usage(void)
           "  --start-addr addr\tSet the start/load address\n"
           "  --sync-lines\t\tAccept line markers in the info file\n"
           "  --text-column n\tSpecify text start column\n"
+          "  --trace\t\tTrace the code flow to find code and data\n"
           "  --verbose\t\tIncrease verbosity\n"
           "  --version\t\tPrint the disassembler version\n",
           ProgName);
@@ -318,6 +320,13 @@ static void OptTextColumn(const char *Opt, const char *Arg)
    TCol = (unsigned char)Val;
 }
 
+static void OptTrace(const char *Opt attribute((unused)),
+                     const char *Arg attribute((unused)))
+// Handle the --trace option
+{
+   TraceCode = 1;
+}
+
 static void OptVerbose(const char *Opt attribute((unused)),
                        const char *Arg attribute((unused)))
 // Increase verbosity
@@ -553,13 +562,20 @@ static void OnePass(void)
 static void Disassemble(void)
 // Disassemble the code
 {
+   // If the --trace option is given, separate code and data by following the
+   // code flow. Since this fixes the code and data ranges, new labels cannot
+   // change the disassembly, and one preparation pass finds all of them.
+   if (TraceCode) {
+      TraceCodeFlow();
+   }
+
    // Preparation pass
    Pass = PASS_PREP;
    OnePass();
 
    // If the --multi-pass option is given, repeat this pass until we have no
    // new labels.
-   if (MultiPass) {
+   if (MultiPass && !TraceCode) {
       unsigned long LabelCount = GetLabelCount();
       unsigned Passes = 1;
       while (1) {
@@ -612,6 +628,7 @@ int main(int argc, char *argv[])
        {"--start-addr", 1, OptStartAddr},
        {"--sync-lines", 0, OptSyncLines},
        {"--text-column", 1, OptTextColumn},
+       {"--trace", 0, OptTrace},
        {"--verbose", 0, OptVerbose},
        {"--version", 0, OptVersion},
    };
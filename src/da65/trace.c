@@ -0,0 +1,277 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//                                  trace.c
+//
+//                             Code flow tracing
+//
+//
+//
+// (C) 2026, The cc65 Authors
+//
+//
+// This software is provided 'as-is', without any expressed or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string.h>
+
+// common
+#include "cpu.h"
+#include "debugflag.h"
+#include "xmalloc.h"
+
+// da65
+#include "attrtab.h"
+#include "code.h"
+#include "error.h"
+#include "global.h"
+#include "handler.h"
+#include "opctable.h"
+#include "trace.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//                                   Data
+////////////////////////////////////////////////////////////////////////////////
+
+// Flags for the code bytes
+#define TF_INSN 0x01 // Start of an instruction
+#define TF_CODE 0x02 // Part of an instruction
+
+// Flags for all code bytes, indexed by the offset from CodeStart
+static unsigned char *Flags = 0;
+
+// Addresses where the tracing must continue
+static uint32_t *WorkList = 0;
+static unsigned WorkCount = 0;
+static unsigned WorkMax = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+//                                   Code
+////////////////////////////////////////////////////////////////////////////////
+
+static int InCode(uint32_t Addr)
+// Return true if the address is within the code
+{
+   return Addr >= CodeStart && Addr <= CodeEnd;
+}
+
+static void AddEntry(uint32_t Addr)
+// Add an address to the work list if it's within the code and not yet traced
+{
+   if (InCode(Addr) && (Flags[Addr - CodeStart] & TF_INSN) == 0) {
+      if (WorkCount == WorkMax) {
+         WorkMax = WorkMax ? WorkMax * 2 : 256;
+         WorkList = xrealloc(WorkList, WorkMax * sizeof(WorkList[0]));
+      }
+      WorkList[WorkCount++] = Addr;
+   }
+}
+
+static int IsMnemo(const OpcDesc *D, const char *const *List)
+// Return true if the mnemonic of D is in the NULL terminated list
+{
+   while (*List) {
+      if (strcmp(D->Mnemo, *List++) == 0) {
+         return 1;
+      }
+   }
+   return 0;
+}
+
+static int FallsThrough(const OpcDesc *D)
+// Return true if execution may continue with the next instruction
+{
+   static const char *const Stops[] = {
+       "brk", "bra", "brl", "jml", "jmp", "rti", "rtl", "rtn", "rts", "stp", 0,
+   };
+   return !IsMnemo(D, Stops);
+}
+
+static int GetTarget(const OpcDesc *D, uint32_t Addr, uint32_t *Target)
+// Get the target of a jump, call or branch at Addr. Return false if the
+// instruction has no known target.
+{
+   static const char *const Jumps[] = {"jmp", "jsr", 0};
+
+   if (D->Handler == OH_Relative) {
+      *Target = (((int)Addr + 2) + (signed char)GetCodeByte(Addr + 1)) & 0xFFFF;
+   }
+   else if (D->Handler == OH_RelativeLong) {
+      *Target = (((int)Addr + 3) + (signed short)GetCodeWord(Addr + 1)) & 0xFFFF;
+   }
+   else if (D->Handler == OH_RelativeLong4510) {
+      *Target = (((int)Addr + 2) + (signed short)GetCodeWord(Addr + 1)) & 0xFFFF;
+   }
+   else if (D->Handler == OH_BitBranch || D->Handler == OH_BitBranch_m740) {
+      *Target = (((int)Addr + 3) + (int8_t)GetCodeByte(Addr + 2)) & 0xFFFF;
+   }
+   else if (D->Handler == OH_AccumulatorBitBranch) {
+      *Target = (((int)Addr + 3) + (int8_t)GetCodeByte(Addr + 1)) & 0xFFFF;
+   }
+   else if (D->Handler == OH_JmpAbsolute || D->Handler == OH_JsrAbsolute ||
+            (D->Handler == OH_Absolute && IsMnemo(D, Jumps))) {
+      *Target = GetCodeWord(Addr + 1);
+   }
+   else if (D->Handler == OH_SpecialPage) {
+      *Target = 0xFF00 + GetCodeByte(Addr + 1);
+   }
+   else {
+      return 0;
+   }
+   return 1;
+}
+
+static void Trace(uint32_t Addr)
+// Follow the code flow starting at Addr until it ends or reaches code that
+// was already traced
+{
+   while (InCode(Addr)) {
+
+      uint32_t Offs = Addr - CodeStart;
+      const OpcDesc *D = &OpcTable[GetCodeByte(Addr)];
+      uint32_t Target;
+      unsigned I;
+
+      // Stop at illegal instructions, at instructions that don't fit into
+      // the code, and at data given in the info file
+      if ((D->Flags & flIllegal) != 0 || Addr + D->Size - 1 > CodeEnd) {
+         return;
+      }
+      for (I = 0; I < D->Size; ++I) {
+         attr_t Style = GetStyleAttr(Addr + I);
+         if ((Flags[Offs + I] & TF_CODE) != 0 ||
+             (Style != atDefault && Style != atCode)) {
+            return;
+         }
+      }
+
+      // Mark the instruction
+      Flags[Offs] |= TF_INSN;
+      for (I = 0; I < D->Size; ++I) {
+         Flags[Offs + I] |= TF_CODE;
+      }
+
+      // Remember the target of jumps, calls and branches
+      if (GetTarget(D, Addr, &Target)) {
+         AddEntry(Target);
+      }
+
+      // Continue with the next instruction if there is one. Parameters of
+      // subroutines are skipped.
+      if (!FallsThrough(D)) {
+         return;
+      }
+      if (D->Handler == OH_JsrAbsolute) {
+         Addr += GetSubroutineParamSize(GetCodeWord(Addr + 1));
+      }
+      Addr += D->Size;
+   }
+}
+
+static void AddTableEntries(uint32_t Addr, attr_t Style)
+// Add the entries of an address or RTS table starting at Addr
+{
+   while (Addr < CodeEnd && GetStyleAttr(Addr) == Style) {
+      uint16_t Entry = GetCodeWord(Addr);
+      AddEntry(Style == atRtsTab ? (Entry + 1) & 0xFFFF : Entry);
+      Addr += 2;
+   }
+}
+
+static void AddEntryPoints(void)
+// Add the entry points of the code to the work list. These are the start of
+// the code ranges and the entries of address tables given in the info file,
+// and the CPU vectors if they are part of the code. If there are none, the
+// code is entered at its start.
+{
+   static const uint32_t Vectors[] = {0xFFFA, 0xFFFC, 0xFFFE};
+   attr_t Prev = atDefault;
+   uint32_t Addr;
+   unsigned I;
+
+   for (Addr = CodeStart; Addr <= CodeEnd; ++Addr) {
+      attr_t Style = GetStyleAttr(Addr);
+      if (Style != Prev) {
+         if (Style == atCode) {
+            AddEntry(Addr);
+         }
+         else if (Style == atAddrTab || Style == atRtsTab) {
+            AddTableEntries(Addr, Style);
+         }
+      }
+      Prev = Style;
+   }
+
+   if (InCode(0xFFFA) && InCode(0xFFFF)) {
+      for (I = 0; I < sizeof(Vectors) / sizeof(Vectors[0]); ++I) {
+         AddEntry(GetCodeWord(Vectors[I]));
+      }
+      if (GetStyleAttr(0xFFFA) == atDefault &&
+          GetStyleAttr(0xFFFF) == atDefault) {
+         MarkRange(0xFFFA, 0xFFFF, atAddrTab);
+      }
+   }
+
+   if (WorkCount == 0) {
+      AddEntry(CodeStart);
+   }
+}
+
+void TraceCodeFlow(void)
+// Follow the code flow from the entry points and mark all reachable
+// instructions as code and all other bytes without a style as data
+{
+   uint32_t Addr;
+   unsigned long Insns = 0;
+
+   // The size of 65816 instructions depends on the processor state, which
+   // is only known from the info file
+   if (CPU == CPU_65816) {
+      Warning("Code flow tracing is not supported for the 65816");
+      return;
+   }
+
+   // Trace the code from all entry points
+   Flags = xmalloc(CodeEnd - CodeStart + 1);
+   memset(Flags, 0, CodeEnd - CodeStart + 1);
+   AddEntryPoints();
+   while (WorkCount > 0) {
+      Trace(WorkList[--WorkCount]);
+   }
+
+   // Mark the code and the data
+   for (Addr = CodeStart; Addr <= CodeEnd; ++Addr) {
+      unsigned char F = Flags[Addr - CodeStart];
+      if (F & TF_INSN) {
+         ++Insns;
+      }
+      if (GetStyleAttr(Addr) == atDefault) {
+         MarkAddr(Addr, (F & TF_CODE) ? atCode : atByteTab);
+      }
+   }
+   if (Debug) {
+      printf("Traced %lu instructions\n", Insns);
+   }
+
+   xfree(Flags);
+   Flags = 0;
+   xfree(WorkList);
+   WorkList = 0;
+   WorkCount = WorkMax = 0;
+}
@@ -39,6 +39,22 @@
 #include <limits.h>
 #include <assert.h>
 #include <errno.h>
+#include <stdint.h>
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+// Files are mapped into memory where mmap() is available
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVE_MMAP 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include "dbginfo.h"
 
@@ -53,6 +69,20 @@
 #define VER_MAJOR 2U
 #define VER_MINOR 0U
 
+// The binary cache written next to a debug info file. The name of the cache
+// is the name of the debug info file with CACHE_SUFFIX appended.
+#define CACHE_SUFFIX ".cache"
+#define CACHE_MAGIC 0x63643635U // Also detects a different byte order
+#define CACHE_VERSION 1U
+
+// Contents of a file in memory
+typedef struct FileData FileData;
+struct FileData {
+   const char *Data; // File contents
+   size_t Size;      // Size of the file
+   int Mapped;       // True if mapped with mmap(), otherwise allocated
+};
+
 // Dynamic strings
 typedef struct StrBuf StrBuf;
 struct StrBuf {
@@ -100,6 +130,28 @@ struct SpanInfoList {
    SpanInfoListEntry *List; // Dynamic array with entries
 };
 
+// Address map. Each entry is a range of addresses with the same innermost
+// span, line and scope. The entries are sorted by address and don't overlap.
+// A page index contains the first entry that ends in or after each page of
+// 2^ADDRMAP_PAGE_SHIFT addresses, so a lookup searches only a few entries.
+#define ADDRMAP_PAGE_SHIFT 8U
+typedef struct AddrMapEntry AddrMapEntry;
+struct AddrMapEntry {
+   cc65_addr Start;  // First address of the range
+   cc65_addr End;    // Last address of the range
+   unsigned SpanId;  // Id of the innermost span
+   unsigned LineId;  // Id of the line
+   unsigned ScopeId; // Id of the innermost scope
+};
+
+typedef struct AddrMap AddrMap;
+struct AddrMap {
+   unsigned Count;     // Number of entries
+   AddrMapEntry *List; // Dynamic array with entries
+   unsigned PageCount; // Number of pages in the page index
+   unsigned *Pages;    // Page index with PageCount + 1 entries
+};
+
 // Input tokens
 typedef enum {
 
@@ -197,9 +249,11 @@ struct DbgInfo {
    Collection SegInfoByName;   // Segment infos sorted by name
    Collection SymInfoByName;   // Symbol infos sorted by name
    Collection SymInfoByVal;    // Symbol infos sorted by value
+   Collection LabelInfoByVal;  // Labels sorted by value
 
    // Other stuff
    SpanInfoList SpanInfoByAddr; // Span infos sorted by unique address
+   AddrMap AddrMap;             // Innermost items by address
 
    // Info data
    unsigned long MemUsage; // Memory usage for the data
@@ -217,7 +271,10 @@ struct InputData {
    cc65_line SLine;      // Line number at start of token
    unsigned SCol;        // Column number at start of token
    unsigned Errors;      // Number of errors
-   FILE *F;              // Input file
+   unsigned Warnings;    // Number of warnings
+   const char *Buf;      // Contents of the input file
+   size_t Size;          // Size of the input file
+   size_t Pos;           // Position of the next input character
    int C;                // Input character
    Token Tok;            // Token from input stream
    unsigned long IVal;   // Integer constant
@@ -1012,10 +1069,13 @@ static void ParseError(InputData *D, cc65_error_severity Type, const char *Msg,
    // Free the data structure
    xfree(E);
 
-   // Count errors
+   // Count errors and warnings
    if (Type == CC65_ERROR) {
       ++D->Errors;
    }
+   else {
+      ++D->Warnings;
+   }
 }
 
 static void SkipLine(InputData *D)
@@ -2111,6 +2171,214 @@ static void DoneSpanInfoList(SpanInfoList *L)
    xfree(L->List);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//                                Address map
+////////////////////////////////////////////////////////////////////////////////
+
+static void InitAddrMap(AddrMap *M)
+// Initialize an address map
+{
+   M->Count = 0;
+   M->List = 0;
+   M->PageCount = 0;
+   M->Pages = 0;
+}
+
+static void DoneAddrMap(AddrMap *M)
+// Delete the contents of an address map
+{
+   xfree(M->List);
+   xfree(M->Pages);
+}
+
+static unsigned GetScopeDepth(const ScopeInfo *S)
+// Return the nesting depth of a scope
+{
+   unsigned Depth = 0;
+   while ((S = S->Parent.Info) != 0) {
+      ++Depth;
+   }
+   return Depth;
+}
+
+static unsigned GetLinePriority(const LineInfo *L)
+// Return the priority of a line when looking for the line of an address.
+// Lower values are preferred.
+{
+   switch (L->Type) {
+      case CC65_LINE_EXT:
+         return 0;
+      case CC65_LINE_ASM:
+         return 1;
+      default:
+         return 2;
+   }
+}
+
+static void FindInnermost(AddrMapEntry *E, SpanInfo **Spans, unsigned Count)
+// Determine the innermost span, line and scope from the spans for an address
+{
+   const SpanInfo *Span = 0;
+   const LineInfo *Line = 0;
+   const ScopeInfo *Scope = 0;
+   cc65_size SpanSize = 0;
+   cc65_size LineSize = 0;
+   cc65_size ScopeSize = 0;
+   unsigned LinePrio = 0;
+   unsigned ScopeDepth = 0;
+   unsigned I, J;
+
+   for (I = 0; I < Count; ++I) {
+
+      const SpanInfo *S = Spans[I];
+      cc65_size Size = S->End - S->Start;
+
+      // The smallest span
+      if (Span == 0 || Size < SpanSize) {
+         Span = S;
+         SpanSize = Size;
+      }
+
+      // The line with the best priority, from the smallest span
+      for (J = 0; J < CollCount(S->LineInfoList); ++J) {
+         const LineInfo *L = CollAt(S->LineInfoList, J);
+         unsigned Prio = GetLinePriority(L);
+         if (Line == 0 || Prio < LinePrio ||
+             (Prio == LinePrio && Size < LineSize)) {
+            Line = L;
+            LinePrio = Prio;
+            LineSize = Size;
+         }
+      }
+
+      // The deepest scope from the smallest span
+      for (J = 0; J < CollCount(S->ScopeInfoList); ++J) {
+         const ScopeInfo *Sc = CollAt(S->ScopeInfoList, J);
+         unsigned Depth = GetScopeDepth(Sc);
+         if (Scope == 0 || Size < ScopeSize ||
+             (Size == ScopeSize && Depth > ScopeDepth)) {
+            Scope = Sc;
+            ScopeSize = Size;
+            ScopeDepth = Depth;
+         }
+      }
+   }
+
+   E->SpanId = GetId(Span);
+   E->LineId = GetId(Line);
+   E->ScopeId = GetId(Scope);
+}
+
+static void CreateAddrMap(AddrMap *M, const SpanInfoList *L)
+// Create the address map from the span info list. Consecutive addresses with
+// the same innermost items are merged into one entry.
+{
+   unsigned I, J;
+
+   M->Count = 0;
+   M->List = xmalloc(L->Count * sizeof(M->List[0]));
+   M->PageCount = 0;
+   M->Pages = 0;
+
+   for (I = 0; I < L->Count; ++I) {
+
+      const SpanInfoListEntry *LE = &L->List[I];
+      AddrMapEntry E;
+
+      // For a count of 1, Data is the span itself
+      if (LE->Count == 1) {
+         SpanInfo *S = LE->Data;
+         FindInnermost(&E, &S, 1);
+      }
+      else {
+         FindInnermost(&E, LE->Data, LE->Count);
+      }
+      E.Start = E.End = LE->Addr;
+
+      // Extend the previous entry if possible
+      if (M->Count > 0) {
+         AddrMapEntry *Prev = &M->List[M->Count - 1];
+         if (Prev->End + 1 == E.Start && Prev->SpanId == E.SpanId &&
+             Prev->LineId == E.LineId && Prev->ScopeId == E.ScopeId) {
+            Prev->End = E.End;
+            continue;
+         }
+      }
+      M->List[M->Count++] = E;
+   }
+
+   // Create the page index. The entry after the last page is the entry
+   // count.
+   if (M->Count > 0) {
+      M->PageCount = (M->List[M->Count - 1].End >> ADDRMAP_PAGE_SHIFT) + 1;
+      M->Pages = xmalloc((M->PageCount + 1) * sizeof(M->Pages[0]));
+      for (I = 0, J = 0; I < M->PageCount; ++I) {
+         while ((M->List[J].End >> ADDRMAP_PAGE_SHIFT) < I) {
+            ++J;
+         }
+         M->Pages[I] = J;
+      }
+      M->Pages[M->PageCount] = M->Count;
+   }
+}
+
+static const AddrMapEntry *FindAddrMapEntry(const AddrMap *M, cc65_addr Addr,
+                                            unsigned *Last)
+// Find the address map entry for an address. Returns 0 if no such entry was
+// found. Last is the index of the entry found last by the caller, and is
+// updated if an entry is found.
+{
+   const AddrMapEntry *E;
+   unsigned Page;
+   int Lo, Hi;
+
+   // Addresses are often looked up in order, so check the entry found last
+   // and the one following it first
+   if (*Last < M->Count) {
+      E = &M->List[*Last];
+      if (Addr >= E->Start && Addr <= E->End) {
+         return E;
+      }
+      if (*Last + 1 < M->Count && Addr > E->End) {
+         ++E;
+         if (Addr >= E->Start && Addr <= E->End) {
+            ++*Last;
+            return E;
+         }
+      }
+   }
+
+   // Addresses after the last page are never found
+   Page = Addr >> ADDRMAP_PAGE_SHIFT;
+   if (Page >= M->PageCount) {
+      return 0;
+   }
+
+   // The entry is the last one that starts at or below Addr. It is one of
+   // the entries ending in this page, or the first one ending after it.
+   Lo = (int)M->Pages[Page];
+   Hi = (int)M->Pages[Page + 1];
+   if (Hi >= (int)M->Count) {
+      Hi = (int)M->Count - 1;
+   }
+   while (Lo <= Hi) {
+      int Cur = (Lo + Hi) / 2;
+      if (M->List[Cur].Start > Addr) {
+         Hi = Cur - 1;
+      }
+      else {
+         Lo = Cur + 1;
+      }
+   }
+
+   // Hi is now the index of this entry, or before the first candidate
+   if (Hi < (int)M->Pages[Page] || Addr > M->List[Hi].End) {
+      return 0;
+   }
+   *Last = Hi;
+   return &M->List[Hi];
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                Debug info
 ////////////////////////////////////////////////////////////////////////////////
@@ -2143,8 +2411,10 @@ static DbgInfo *NewDbgInfo(const char *FileName)
    CollInit(&Info->SegInfoByName);
    CollInit(&Info->SymInfoByName);
    CollInit(&Info->SymInfoByVal);
+   CollInit(&Info->LabelInfoByVal);
 
    InitSpanInfoList(&Info->SpanInfoByAddr);
+   InitAddrMap(&Info->AddrMap);
 
    Info->MemUsage = 0;
    Info->MajorVersion = 0;
@@ -2212,9 +2482,11 @@ static void FreeDbgInfo(DbgInfo *Info)
    CollDone(&Info->SegInfoByName);
    CollDone(&Info->SymInfoByName);
    CollDone(&Info->SymInfoByVal);
+   CollDone(&Info->LabelInfoByVal);
 
-   // Free span info
+   // Free span info and the address map
    DoneSpanInfoList(&Info->SpanInfoByAddr);
+   DoneAddrMap(&Info->AddrMap);
 
    // Free the structure itself
    xfree(Info);
@@ -2247,7 +2519,12 @@ static void NextChar(InputData *D)
          ++D->Line;
          D->Col = 0;
       }
-      D->C = fgetc(D->F);
+      if (D->Pos < D->Size) {
+         D->C = (unsigned char)D->Buf[D->Pos++];
+      }
+      else {
+         D->C = EOF;
+      }
       ++D->Col;
    }
 }
@@ -3869,7 +4146,6 @@ static void ParseSym(InputData *D)
    // overwritten later. This is just to avoid compiler warnings.
    Collection DefLineIds = COLLECTION_INITIALIZER;
    unsigned ExportId = CC65_INV_ID;
-   unsigned FileId = CC65_INV_ID;
    unsigned Id = CC65_INV_ID;
    StrBuf Name = STRBUF_INITIALIZER;
    unsigned ParentId = CC65_INV_ID;
@@ -3969,7 +4245,6 @@ static void ParseSym(InputData *D)
             if (!IntConstFollows(D)) {
                goto ErrorExit;
             }
-            FileId = D->IVal;
             InfoBits |= ibFileId;
             NextToken(D);
             break;
@@ -4366,47 +4641,6 @@ static int FindCSymInfoByName(const Collection *CSymInfos, const char *Name,
    return Found;
 }
 
-static int FindFileInfoByName(const Collection *FileInfos, const char *Name,
-                              unsigned *Index)
-// Find the FileInfo for a given file name. The function returns true if the
-// name was found. In this case, Index contains the index of the first item
-// that matches. If the item wasn't found, the function returns false and
-// Index contains the insert position for Name.
-{
-   // Do a binary search
-   int Lo = 0;
-   int Hi = (int)CollCount(FileInfos) - 1;
-   int Found = 0;
-   while (Lo <= Hi) {
-
-      // Mid of range
-      int Cur = (Lo + Hi) / 2;
-
-      // Get item
-      const FileInfo *CurItem = CollAt(FileInfos, Cur);
-
-      // Compare
-      int Res = strcmp(CurItem->Name, Name);
-
-      // Found?
-      if (Res < 0) {
-         Lo = Cur + 1;
-      }
-      else {
-         Hi = Cur - 1;
-         // Since we may have duplicates, repeat the search until we've
-         // the first item that has a match.
-         if (Res == 0) {
-            Found = 1;
-         }
-      }
-   }
-
-   // Pass back the index. This is also the insert position
-   *Index = Lo;
-   return Found;
-}
-
 static SpanInfoListEntry *FindSpanInfoByAddr(const SpanInfoList *L,
                                              cc65_addr Addr)
 // Find the index of a SpanInfo for a given address. Returns 0 if no such
@@ -4595,6 +4829,18 @@ static int FindSymInfoByName(const Collection *SymInfos, const char *Name,
    return Found;
 }
 
+static void CollectLabels(Collection *Labels, const Collection *SymInfos)
+// Add all labels from a collection of symbols to Labels, keeping the order
+{
+   unsigned I;
+   for (I = 0; I < CollCount(SymInfos); ++I) {
+      SymInfo *S = CollAt(SymInfos, I);
+      if (S->Type == CC65_SYM_LABEL) {
+         CollAppend(Labels, S);
+      }
+   }
+}
+
 static int FindSymInfoByValue(const Collection *SymInfos, long Value,
                               unsigned *Index)
 // Find the SymInfo for a given value. The function returns true if the
@@ -5087,6 +5333,9 @@ static void ProcessSpanInfo(InputData *D)
 
    // Remove the temporary collection
    CollDone(&SpanInfoByAddr);
+
+   // Create the address map from the span info list
+   CreateAddrMap(&D->Info->AddrMap, &D->Info->SpanInfoByAddr);
 }
 
 static void ProcessSymInfo(InputData *D)
@@ -5246,6 +5495,854 @@ static void ProcessSymInfo(InputData *D)
    // Sort the symbol infos
    CollSort(&D->Info->SymInfoByName, CompareSymInfoByName);
    CollSort(&D->Info->SymInfoByVal, CompareSymInfoByVal);
+
+   // Remember the labels separately for lookups by address
+   CollectLabels(&D->Info->LabelInfoByVal, &D->Info->SymInfoByVal);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                 File data
+////////////////////////////////////////////////////////////////////////////////
+
+static int ReadFileData(FileData *F, const char *Name)
+// Map a file into memory, or read it if it cannot be mapped. Return zero on
+// success. On failure, errno contains the reason.
+{
+   FILE *In;
+   char *Buf = 0;
+   size_t Size = 0;
+   size_t Allocated = 0;
+   size_t Count;
+   int Err;
+
+#if defined(HAVE_MMAP)
+   // Map regular files
+   struct stat St;
+   int FD = open(Name, O_RDONLY);
+   if (FD < 0) {
+      return -1;
+   }
+   if (fstat(FD, &St) == 0 && S_ISREG(St.st_mode) && St.st_size > 0) {
+      void *P = mmap(0, St.st_size, PROT_READ, MAP_PRIVATE, FD, 0);
+      if (P != MAP_FAILED) {
+         close(FD);
+         F->Data = P;
+         F->Size = St.st_size;
+         F->Mapped = 1;
+         return 0;
+      }
+   }
+   close(FD);
+#endif
+
+   // Read the file
+   In = fopen(Name, "rb");
+   if (In == 0) {
+      return -1;
+   }
+   do {
+      if (Size == Allocated) {
+         Allocated = Allocated ? Allocated * 2 : 0x10000;
+         Buf = xrealloc(Buf, Allocated);
+      }
+      Count = fread(Buf + Size, 1, Allocated - Size, In);
+      Size += Count;
+   } while (Count > 0);
+   if (ferror(In)) {
+      Err = errno;
+      fclose(In);
+      xfree(Buf);
+      errno = Err;
+      return -1;
+   }
+   fclose(In);
+
+   F->Data = Buf;
+   F->Size = Size;
+   F->Mapped = 0;
+   return 0;
+}
+
+static void FreeFileData(FileData *F)
+// Free the contents of a file read by ReadFileData
+{
+#if defined(HAVE_MMAP)
+   if (F->Mapped) {
+      munmap((void *)F->Data, F->Size);
+      return;
+   }
+#endif
+   xfree((void *)F->Data);
+}
+
+static uint64_t HashFileData(const FileData *F)
+// Return a FNV-1a hash of the file contents that is used to detect a stale
+// cache. The data is hashed in words, so this is cheap compared to parsing.
+{
+   uint64_t H = 14695981039346656037ULL;
+   uint64_t W;
+   size_t I;
+
+   for (I = 0; I + sizeof(W) <= F->Size; I += sizeof(W)) {
+      memcpy(&W, F->Data + I, sizeof(W));
+      H = (H ^ W) * 1099511628211ULL;
+   }
+   for (; I < F->Size; ++I) {
+      H = (H ^ (unsigned char)F->Data[I]) * 1099511628211ULL;
+   }
+   return H;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                              Debug info cache
+////////////////////////////////////////////////////////////////////////////////
+
+// The cache contains the debug info after postprocessing, so loading it
+// needs neither parsing nor sorting. It is a sequence of 32 bit words in
+// native byte order: A header with the size and the hash of the debug info
+// file, the item counts, the plain data of all items, the references of all
+// items with the sorted collections, and the global sorted collections.
+// Pointers are stored as ids, NULL pointers as CC65_INV_ID. Strings are
+// stored as length followed by the zero terminated characters, padded to a
+// word boundary.
+
+// Buffer used when writing the cache
+typedef struct CacheOutput CacheOutput;
+struct CacheOutput {
+   uint32_t *Data; // Words written so far
+   size_t Count;   // Number of words
+   size_t Size;    // Size of the allocated buffer in words
+};
+
+// Cache data when reading
+typedef struct CacheInput CacheInput;
+struct CacheInput {
+   const uint32_t *Data; // Words in the cache
+   size_t Count;         // Number of words
+   size_t Pos;           // Index of the next word
+   int Error;            // True if the cache is invalid
+};
+
+static void CachePut(CacheOutput *C, uint32_t V)
+// Write a word to the cache
+{
+   if (C->Count == C->Size) {
+      C->Size = C->Size ? C->Size * 2 : 0x10000;
+      C->Data = xrealloc(C->Data, C->Size * sizeof(C->Data[0]));
+   }
+   C->Data[C->Count++] = V;
+}
+
+static void CachePut64(CacheOutput *C, uint64_t V)
+// Write a 64 bit value to the cache
+{
+   CachePut(C, (uint32_t)V);
+   CachePut(C, (uint32_t)(V >> 32));
+}
+
+static void CachePutStr(CacheOutput *C, const char *S)
+// Write a string to the cache
+{
+   size_t Len = strlen(S);
+   size_t I;
+
+   CachePut(C, (uint32_t)Len);
+   for (I = 0; I <= Len; I += sizeof(uint32_t)) {
+      uint32_t W = 0;
+      memcpy(&W, S + I, Len + 1 - I < sizeof(W) ? Len + 1 - I : sizeof(W));
+      CachePut(C, W);
+   }
+}
+
+static void CachePutColl(CacheOutput *C, const Collection *Coll)
+// Write a collection of items to the cache
+{
+   unsigned I;
+
+   CachePut(C, CollCount(Coll));
+   for (I = 0; I < CollCount(Coll); ++I) {
+      CachePut(C, GetId(CollAt(Coll, I)));
+   }
+}
+
+static void CachePutCollPtr(CacheOutput *C, const Collection *Coll)
+// Write a collection that may be missing to the cache
+{
+   if (Coll == 0) {
+      CachePut(C, CC65_INV_ID);
+   }
+   else {
+      CachePutColl(C, Coll);
+   }
+}
+
+static void CachePutType(CacheOutput *C, const TypeInfo *T)
+// Write the type data of a type to the cache. The entries are written as
+// indices into the array of type data.
+{
+   const cc65_typedata *D;
+   unsigned Count = 0;
+   unsigned I;
+
+   // All entries are reachable from the first one, and they are allocated
+   // in order, so the highest index referenced determines the count.
+   for (I = 0; I <= Count; ++I) {
+      D = &T->Data[I];
+      if (D->next && (unsigned)(D->next - T->Data) > Count) {
+         Count = D->next - T->Data;
+      }
+      if ((D->what == CC65_TYPE_PTR || D->what == CC65_TYPE_FARPTR) &&
+          (unsigned)(D->data.ptr.ind_type - T->Data) > Count) {
+         Count = D->data.ptr.ind_type - T->Data;
+      }
+      if (D->what == CC65_TYPE_ARRAY &&
+          (unsigned)(D->data.array.ele_type - T->Data) > Count) {
+         Count = D->data.array.ele_type - T->Data;
+      }
+   }
+
+   CachePut(C, Count + 1);
+   for (I = 0; I <= Count; ++I) {
+      D = &T->Data[I];
+      CachePut(C, D->what);
+      CachePut(C, D->size);
+      CachePut(C, D->next ? (uint32_t)(D->next - T->Data) : CC65_INV_ID);
+      if (D->what == CC65_TYPE_PTR || D->what == CC65_TYPE_FARPTR) {
+         CachePut(C, D->data.ptr.ind_type - T->Data);
+      }
+      else if (D->what == CC65_TYPE_ARRAY) {
+         CachePut(C, D->data.array.ele_count);
+         CachePut(C, D->data.array.ele_type - T->Data);
+      }
+   }
+}
+
+static char *GetCacheName(const char *FileName)
+// Return the name of the cache for a debug info file. The name is allocated
+// and must be freed by the caller.
+{
+   char *Name = xmalloc(strlen(FileName) + sizeof(CACHE_SUFFIX));
+   strcpy(Name, FileName);
+   strcat(Name, CACHE_SUFFIX);
+   return Name;
+}
+
+static int HasAllItems(const Collection *C)
+// Return true if no id is missing in a collection sorted by id
+{
+   unsigned I;
+   for (I = 0; I < CollCount(C); ++I) {
+      if (CollAt(C, I) == 0) {
+         return 0;
+      }
+   }
+   return 1;
+}
+
+static void WriteCache(const DbgInfo *Info, size_t Size, uint64_t Hash)
+// Write the cache for a debug info file with the given size and hash. Since
+// the cache is an optimization, it is silently skipped if it cannot be
+// written.
+{
+   CacheOutput C = {0, 0, 0};
+   const Collection *ById[10];
+   char *Name;
+   char *TmpName;
+   FILE *Out;
+   int Ok;
+   unsigned I, J;
+
+   // The items in the collections sorted by id are referenced by index
+   ById[0] = &Info->CSymInfoById;
+   ById[1] = &Info->FileInfoById;
+   ById[2] = &Info->LibInfoById;
+   ById[3] = &Info->LineInfoById;
+   ById[4] = &Info->ModInfoById;
+   ById[5] = &Info->ScopeInfoById;
+   ById[6] = &Info->SegInfoById;
+   ById[7] = &Info->SpanInfoById;
+   ById[8] = &Info->SymInfoById;
+   ById[9] = &Info->TypeInfoById;
+   for (I = 0; I < sizeof(ById) / sizeof(ById[0]); ++I) {
+      if (!HasAllItems(ById[I])) {
+         return;
+      }
+   }
+
+   // Header
+   CachePut(&C, CACHE_MAGIC);
+   CachePut(&C, CACHE_VERSION);
+   CachePut64(&C, Size);
+   CachePut64(&C, Hash);
+   CachePut(&C, Info->MajorVersion);
+   CachePut(&C, Info->MinorVersion);
+   for (I = 0; I < sizeof(ById) / sizeof(ById[0]); ++I) {
+      CachePut(&C, CollCount(ById[I]));
+   }
+
+   // Plain data of the items
+   for (I = 0; I < CollCount(&Info->CSymInfoById); ++I) {
+      const CSymInfo *S = CollAt(&Info->CSymInfoById, I);
+      CachePut(&C, S->Kind);
+      CachePut(&C, S->SC);
+      CachePut(&C, S->Offs);
+      CachePutStr(&C, S->Name);
+   }
+   for (I = 0; I < CollCount(&Info->FileInfoById); ++I) {
+      const FileInfo *F = CollAt(&Info->FileInfoById, I);
+      CachePut64(&C, F->Size);
+      CachePut64(&C, F->MTime);
+      CachePutStr(&C, F->Name);
+   }
+   for (I = 0; I < CollCount(&Info->LibInfoById); ++I) {
+      const LibInfo *L = CollAt(&Info->LibInfoById, I);
+      CachePutStr(&C, L->Name);
+   }
+   for (I = 0; I < CollCount(&Info->LineInfoById); ++I) {
+      const LineInfo *L = CollAt(&Info->LineInfoById, I);
+      CachePut(&C, L->Line);
+      CachePut(&C, L->Type);
+      CachePut(&C, L->Count);
+   }
+   for (I = 0; I < CollCount(&Info->ModInfoById); ++I) {
+      const ModInfo *M = CollAt(&Info->ModInfoById, I);
+      CachePutStr(&C, M->Name);
+   }
+   for (I = 0; I < CollCount(&Info->ScopeInfoById); ++I) {
+      const ScopeInfo *S = CollAt(&Info->ScopeInfoById, I);
+      CachePut(&C, S->Type);
+      CachePut(&C, S->Size);
+      CachePutStr(&C, S->Name);
+   }
+   for (I = 0; I < CollCount(&Info->SegInfoById); ++I) {
+      const SegInfo *S = CollAt(&Info->SegInfoById, I);
+      CachePut(&C, S->Start);
+      CachePut(&C, S->Size);
+      CachePutStr(&C, S->OutputName ? S->OutputName : "");
+      CachePut64(&C, S->OutputOffs);
+      CachePut(&C, S->Bank);
+      CachePutStr(&C, S->Name);
+   }
+   for (I = 0; I < CollCount(&Info->SpanInfoById); ++I) {
+      const SpanInfo *S = CollAt(&Info->SpanInfoById, I);
+      CachePut(&C, S->Start);
+      CachePut(&C, S->End);
+   }
+   for (I = 0; I < CollCount(&Info->SymInfoById); ++I) {
+      const SymInfo *S = CollAt(&Info->SymInfoById, I);
+      CachePut(&C, S->Type);
+      CachePut64(&C, S->Value);
+      CachePut(&C, S->Size);
+      CachePutStr(&C, S->Name);
+   }
+   for (I = 0; I < CollCount(&Info->TypeInfoById); ++I) {
+      CachePutType(&C, CollAt(&Info->TypeInfoById, I));
+   }
+
+   // References of the items
+   for (I = 0; I < CollCount(&Info->CSymInfoById); ++I) {
+      const CSymInfo *S = CollAt(&Info->CSymInfoById, I);
+      CachePut(&C, GetId(S->Sym.Info));
+      CachePut(&C, GetId(S->Type.Info));
+      CachePut(&C, GetId(S->Scope.Info));
+   }
+   for (I = 0; I < CollCount(&Info->FileInfoById); ++I) {
+      const FileInfo *F = CollAt(&Info->FileInfoById, I);
+      CachePutColl(&C, &F->ModInfoByName);
+      CachePutColl(&C, &F->LineInfoByLine);
+   }
+   for (I = 0; I < CollCount(&Info->LineInfoById); ++I) {
+      const LineInfo *L = CollAt(&Info->LineInfoById, I);
+      CachePut(&C, GetId(L->File.Info));
+      CachePutColl(&C, &L->SpanInfoList);
+   }
+   for (I = 0; I < CollCount(&Info->ModInfoById); ++I) {
+      const ModInfo *M = CollAt(&Info->ModInfoById, I);
+      CachePut(&C, GetId(M->File.Info));
+      CachePut(&C, GetId(M->Lib.Info));
+      CachePut(&C, GetId(M->MainScope));
+      CachePutColl(&C, &M->CSymFuncByName);
+      CachePutColl(&C, &M->FileInfoByName);
+      CachePutColl(&C, &M->ScopeInfoByName);
+   }
+   for (I = 0; I < CollCount(&Info->ScopeInfoById); ++I) {
+      const ScopeInfo *S = CollAt(&Info->ScopeInfoById, I);
+      CachePut(&C, GetId(S->Mod.Info));
+      CachePut(&C, GetId(S->Parent.Info));
+      CachePut(&C, GetId(S->Label.Info));
+      CachePut(&C, GetId(S->CSymFunc));
+      CachePutColl(&C, &S->SpanInfoList);
+      CachePutColl(&C, &S->SymInfoByName);
+      CachePutCollPtr(&C, S->CSymInfoByName);
+      CachePutCollPtr(&C, S->ChildScopeList);
+   }
+   for (I = 0; I < CollCount(&Info->SpanInfoById); ++I) {
+      const SpanInfo *S = CollAt(&Info->SpanInfoById, I);
+      CachePut(&C, GetId(S->Seg.Info));
+      CachePut(&C, GetId(S->Type.Info));
+      CachePutCollPtr(&C, S->ScopeInfoList);
+      CachePutCollPtr(&C, S->LineInfoList);
+   }
+   for (I = 0; I < CollCount(&Info->SymInfoById); ++I) {
+      const SymInfo *S = CollAt(&Info->SymInfoById, I);
+      CachePut(&C, GetId(S->Exp.Info));
+      CachePut(&C, GetId(S->Seg.Info));
+      CachePut(&C, GetId(S->Scope.Info));
+      CachePut(&C, GetId(S->Parent.Info));
+      CachePut(&C, GetId(S->CSym));
+      CachePutCollPtr(&C, S->ImportList);
+      CachePutCollPtr(&C, S->CheapLocals);
+      CachePutColl(&C, &S->DefLineInfoList);
+      CachePutColl(&C, &S->RefLineInfoList);
+   }
+
+   // Global sorted collections
+   CachePutColl(&C, &Info->CSymFuncByName);
+   CachePutColl(&C, &Info->FileInfoByName);
+   CachePutColl(&C, &Info->ModInfoByName);
+   CachePutColl(&C, &Info->ScopeInfoByName);
+   CachePutColl(&C, &Info->SegInfoByName);
+   CachePutColl(&C, &Info->SymInfoByName);
+   CachePutColl(&C, &Info->SymInfoByVal);
+   CachePut(&C, Info->SpanInfoByAddr.Count);
+   for (I = 0; I < Info->SpanInfoByAddr.Count; ++I) {
+      const SpanInfoListEntry *E = &Info->SpanInfoByAddr.List[I];
+      CachePut(&C, E->Addr);
+      CachePut(&C, E->Count);
+      if (E->Count == 1) {
+         CachePut(&C, GetId(E->Data));
+      }
+      else {
+         for (J = 0; J < E->Count; ++J) {
+            CachePut(&C, GetId(((SpanInfo **)E->Data)[J]));
+         }
+      }
+   }
+   CachePut(&C, CACHE_MAGIC);
+
+   // Write the cache to a temporary file first, so a reader never sees a
+   // partially written cache. The name contains the process id, so several
+   // processes may write the cache at the same time.
+   Name = GetCacheName(Info->FileName);
+   TmpName = xmalloc(strlen(Name) + (sizeof(".temp-") - 1) +
+                     2 * sizeof(unsigned int) + 1);
+   sprintf(TmpName, "%s.temp-%X", Name, (unsigned int)getpid());
+   Out = fopen(TmpName, "wb");
+   if (Out) {
+      Ok = fwrite(C.Data, sizeof(C.Data[0]), C.Count, Out) == C.Count;
+      if (fclose(Out) != 0) {
+         Ok = 0;
+      }
+      if (Ok && rename(TmpName, Name) != 0) {
+         // Some systems don't replace existing files
+         remove(Name);
+         Ok = rename(TmpName, Name) == 0;
+      }
+      if (!Ok) {
+         remove(TmpName);
+      }
+   }
+   xfree(TmpName);
+   xfree(Name);
+   xfree(C.Data);
+}
+
+static unsigned CacheGet(CacheInput *C)
+// Read a word from the cache
+{
+   if (C->Pos < C->Count) {
+      return C->Data[C->Pos++];
+   }
+   C->Error = 1;
+   return 0;
+}
+
+static uint64_t CacheGet64(CacheInput *C)
+// Read a 64 bit value from the cache
+{
+   uint64_t V = CacheGet(C);
+   return V | ((uint64_t)CacheGet(C) << 32);
+}
+
+static unsigned CacheGetCount(CacheInput *C)
+// Read a count of words that follow in the cache
+{
+   unsigned Count = CacheGet(C);
+   if (Count > C->Count - C->Pos) {
+      C->Error = 1;
+      return 0;
+   }
+   return Count;
+}
+
+static void CacheGetStr(CacheInput *C, StrBuf *S)
+// Read a string from the cache. S will point into the cache data.
+{
+   unsigned Len = CacheGet(C);
+   size_t Words = Len / sizeof(uint32_t) + 1;
+   const char *Buf = (const char *)(C->Data + C->Pos);
+
+   if (C->Error || Words > C->Count - C->Pos || Buf[Len] != '\0') {
+      C->Error = 1;
+      Buf = "";
+      Len = 0;
+   }
+   else {
+      C->Pos += Words;
+   }
+   S->Buf = (char *)Buf;
+   S->Len = Len;
+   S->Allocated = 0;
+}
+
+static void *CacheGetItem(CacheInput *C, const Collection *Items)
+// Read an id from the cache and return the item with this id
+{
+   unsigned Id = CacheGet(C);
+   if (Id == CC65_INV_ID) {
+      return 0;
+   }
+   if (Id >= CollCount(Items)) {
+      C->Error = 1;
+      return 0;
+   }
+   return CollAt(Items, Id);
+}
+
+static void CacheGetColl(CacheInput *C, Collection *Coll,
+                         const Collection *Items)
+// Read a collection of items from the cache
+{
+   unsigned Count = CacheGetCount(C);
+   CollGrow(Coll, Count);
+   while (Count--) {
+      CollAppend(Coll, CacheGetItem(C, Items));
+   }
+}
+
+static Collection *CacheGetCollPtr(CacheInput *C, const Collection *Items)
+// Read a collection that may be missing from the cache
+{
+   Collection *Coll = 0;
+   if (C->Pos < C->Count && C->Data[C->Pos] == CC65_INV_ID) {
+      ++C->Pos;
+   }
+   else {
+      Coll = CollNew();
+      CacheGetColl(C, Coll, Items);
+   }
+   return Coll;
+}
+
+static const cc65_typedata *CacheGetTypeData(CacheInput *C, TypeInfo *T,
+                                             unsigned Count)
+// Read the index of a type data entry from the cache
+{
+   unsigned Index = CacheGet(C);
+   if (Index >= Count) {
+      C->Error = 1;
+      return 0;
+   }
+   return &T->Data[Index];
+}
+
+static TypeInfo *CacheGetType(CacheInput *C, unsigned Id)
+// Read a type from the cache
+{
+   unsigned Count = CacheGetCount(C);
+   unsigned I;
+   TypeInfo *T;
+
+   if (Count == 0) {
+      Count = 1;
+      C->Error = 1;
+   }
+   T = xmalloc(sizeof(*T) - sizeof(T->Data[0]) + Count * sizeof(T->Data[0]));
+   T->Id = Id;
+   for (I = 0; I < Count; ++I) {
+      cc65_typedata *D = &T->Data[I];
+      D->what = CacheGet(C);
+      D->size = CacheGet(C);
+      if (C->Pos < C->Count && C->Data[C->Pos] == CC65_INV_ID) {
+         ++C->Pos;
+         D->next = 0;
+      }
+      else {
+         D->next = (cc65_typedata *)CacheGetTypeData(C, T, Count);
+      }
+      if (D->what == CC65_TYPE_PTR || D->what == CC65_TYPE_FARPTR) {
+         D->data.ptr.ind_type = CacheGetTypeData(C, T, Count);
+      }
+      else if (D->what == CC65_TYPE_ARRAY) {
+         D->data.array.ele_count = CacheGet(C);
+         D->data.array.ele_type = CacheGetTypeData(C, T, Count);
+      }
+   }
+   return T;
+}
+
+static DbgInfo *ReadCache(const char *FileName, size_t FileSize,
+                          uint64_t Hash)
+// Read the cache for a debug info file with the given size and hash. Return
+// NULL if there is no cache or if it is not up to date.
+{
+   FileData Cache;
+   CacheInput C;
+   DbgInfo *Info;
+   Collection *ById[10];
+   unsigned Count;
+   unsigned I, J;
+
+   // Read the cache and check the header
+   char *CacheName = GetCacheName(FileName);
+   int Res = ReadFileData(&Cache, CacheName);
+   xfree(CacheName);
+   if (Res != 0) {
+      return 0;
+   }
+   C.Data = (const uint32_t *)Cache.Data;
+   C.Count = Cache.Size / sizeof(C.Data[0]);
+   C.Pos = 0;
+   C.Error = 0;
+   if (CacheGet(&C) != CACHE_MAGIC || CacheGet(&C) != CACHE_VERSION ||
+       CacheGet64(&C) != FileSize || CacheGet64(&C) != Hash || C.Error) {
+      FreeFileData(&Cache);
+      return 0;
+   }
+
+   // Create the debug info and the items
+   Info = NewDbgInfo(FileName);
+   Info->MajorVersion = CacheGet(&C);
+   Info->MinorVersion = CacheGet(&C);
+   ById[0] = &Info->CSymInfoById;
+   ById[1] = &Info->FileInfoById;
+   ById[2] = &Info->LibInfoById;
+   ById[3] = &Info->LineInfoById;
+   ById[4] = &Info->ModInfoById;
+   ById[5] = &Info->ScopeInfoById;
+   ById[6] = &Info->SegInfoById;
+   ById[7] = &Info->SpanInfoById;
+   ById[8] = &Info->SymInfoById;
+   ById[9] = &Info->TypeInfoById;
+   for (I = 0; I < sizeof(ById) / sizeof(ById[0]); ++I) {
+      Count = CacheGet(&C);
+      if (Count > C.Count) {
+         C.Error = 1;
+         Count = 0;
+      }
+      CollGrow(ById[I], Count);
+      ById[I]->Count = Count;
+   }
+
+   // Plain data of the items. The counts of the collections sorted by id are
+   // set already, so they are filled directly.
+   for (I = 0; I < CollCount(&Info->CSymInfoById); ++I) {
+      StrBuf Name;
+      CSymInfo *S;
+      unsigned Kind = CacheGet(&C);
+      unsigned SC = CacheGet(&C);
+      int Offs = (int)CacheGet(&C);
+      CacheGetStr(&C, &Name);
+      S = NewCSymInfo(&Name);
+      S->Id = I;
+      S->Kind = Kind;
+      S->SC = SC;
+      S->Offs = Offs;
+      Info->CSymInfoById.Items[I].Ptr = S;
+   }
+   for (I = 0; I < CollCount(&Info->FileInfoById); ++I) {
+      StrBuf Name;
+      FileInfo *F;
+      unsigned long Size = CacheGet64(&C);
+      unsigned long MTime = CacheGet64(&C);
+      CacheGetStr(&C, &Name);
+      F = NewFileInfo(&Name);
+      F->Id = I;
+      F->Size = Size;
+      F->MTime = MTime;
+      Info->FileInfoById.Items[I].Ptr = F;
+   }
+   for (I = 0; I < CollCount(&Info->LibInfoById); ++I) {
+      StrBuf Name;
+      LibInfo *L;
+      CacheGetStr(&C, &Name);
+      L = NewLibInfo(&Name);
+      L->Id = I;
+      Info->LibInfoById.Items[I].Ptr = L;
+   }
+   for (I = 0; I < CollCount(&Info->LineInfoById); ++I) {
+      LineInfo *L = NewLineInfo();
+      L->Id = I;
+      L->Line = CacheGet(&C);
+      L->Type = CacheGet(&C);
+      L->Count = CacheGet(&C);
+      Info->LineInfoById.Items[I].Ptr = L;
+   }
+   for (I = 0; I < CollCount(&Info->ModInfoById); ++I) {
+      StrBuf Name;
+      ModInfo *M;
+      CacheGetStr(&C, &Name);
+      M = NewModInfo(&Name);
+      M->Id = I;
+      Info->ModInfoById.Items[I].Ptr = M;
+   }
+   for (I = 0; I < CollCount(&Info->ScopeInfoById); ++I) {
+      StrBuf Name;
+      ScopeInfo *S;
+      cc65_scope_type Type = CacheGet(&C);
+      cc65_size Size = CacheGet(&C);
+      CacheGetStr(&C, &Name);
+      S = NewScopeInfo(&Name);
+      S->Id = I;
+      S->Type = Type;
+      S->Size = Size;
+      Info->ScopeInfoById.Items[I].Ptr = S;
+   }
+   for (I = 0; I < CollCount(&Info->SegInfoById); ++I) {
+      StrBuf Name;
+      StrBuf OutputName;
+      cc65_addr Start = CacheGet(&C);
+      cc65_size Size = CacheGet(&C);
+      unsigned long OutputOffs;
+      unsigned Bank;
+      CacheGetStr(&C, &OutputName);
+      OutputOffs = CacheGet64(&C);
+      Bank = CacheGet(&C);
+      CacheGetStr(&C, &Name);
+      Info->SegInfoById.Items[I].Ptr =
+          NewSegInfo(&Name, I, Start, Size, &OutputName, OutputOffs, Bank);
+   }
+   for (I = 0; I < CollCount(&Info->SpanInfoById); ++I) {
+      SpanInfo *S = NewSpanInfo();
+      S->Id = I;
+      S->Start = CacheGet(&C);
+      S->End = CacheGet(&C);
+      Info->SpanInfoById.Items[I].Ptr = S;
+   }
+   for (I = 0; I < CollCount(&Info->SymInfoById); ++I) {
+      StrBuf Name;
+      SymInfo *S;
+      cc65_symbol_type Type = CacheGet(&C);
+      long Value = (long)CacheGet64(&C);
+      cc65_size Size = CacheGet(&C);
+      CacheGetStr(&C, &Name);
+      S = NewSymInfo(&Name);
+      S->Id = I;
+      S->Type = Type;
+      S->Value = Value;
+      S->Size = Size;
+      Info->SymInfoById.Items[I].Ptr = S;
+   }
+   for (I = 0; I < CollCount(&Info->TypeInfoById); ++I) {
+      Info->TypeInfoById.Items[I].Ptr = CacheGetType(&C, I);
+   }
+
+   // References of the items
+   for (I = 0; I < CollCount(&Info->CSymInfoById); ++I) {
+      CSymInfo *S = CollAt(&Info->CSymInfoById, I);
+      S->Sym.Info = CacheGetItem(&C, &Info->SymInfoById);
+      S->Type.Info = CacheGetItem(&C, &Info->TypeInfoById);
+      S->Scope.Info = CacheGetItem(&C, &Info->ScopeInfoById);
+   }
+   for (I = 0; I < CollCount(&Info->FileInfoById); ++I) {
+      FileInfo *F = CollAt(&Info->FileInfoById, I);
+      CacheGetColl(&C, &F->ModInfoByName, &Info->ModInfoById);
+      CacheGetColl(&C, &F->LineInfoByLine, &Info->LineInfoById);
+   }
+   for (I = 0; I < CollCount(&Info->LineInfoById); ++I) {
+      LineInfo *L = CollAt(&Info->LineInfoById, I);
+      L->File.Info = CacheGetItem(&C, &Info->FileInfoById);
+      CacheGetColl(&C, &L->SpanInfoList, &Info->SpanInfoById);
+   }
+   for (I = 0; I < CollCount(&Info->ModInfoById); ++I) {
+      ModInfo *M = CollAt(&Info->ModInfoById, I);
+      M->File.Info = CacheGetItem(&C, &Info->FileInfoById);
+      M->Lib.Info = CacheGetItem(&C, &Info->LibInfoById);
+      M->MainScope = CacheGetItem(&C, &Info->ScopeInfoById);
+      CacheGetColl(&C, &M->CSymFuncByName, &Info->CSymInfoById);
+      CacheGetColl(&C, &M->FileInfoByName, &Info->FileInfoById);
+      CacheGetColl(&C, &M->ScopeInfoByName, &Info->ScopeInfoById);
+   }
+   for (I = 0; I < CollCount(&Info->ScopeInfoById); ++I) {
+      ScopeInfo *S = CollAt(&Info->ScopeInfoById, I);
+      S->Mod.Info = CacheGetItem(&C, &Info->ModInfoById);
+      S->Parent.Info = CacheGetItem(&C, &Info->ScopeInfoById);
+      S->Label.Info = CacheGetItem(&C, &Info->SymInfoById);
+      S->CSymFunc = CacheGetItem(&C, &Info->CSymInfoById);
+      CacheGetColl(&C, &S->SpanInfoList, &Info->SpanInfoById);
+      CacheGetColl(&C, &S->SymInfoByName, &Info->SymInfoById);
+      S->CSymInfoByName = CacheGetCollPtr(&C, &Info->CSymInfoById);
+      S->ChildScopeList = CacheGetCollPtr(&C, &Info->ScopeInfoById);
+   }
+   for (I = 0; I < CollCount(&Info->SpanInfoById); ++I) {
+      SpanInfo *S = CollAt(&Info->SpanInfoById, I);
+      S->Seg.Info = CacheGetItem(&C, &Info->SegInfoById);
+      S->Type.Info = CacheGetItem(&C, &Info->TypeInfoById);
+      S->ScopeInfoList = CacheGetCollPtr(&C, &Info->ScopeInfoById);
+      S->LineInfoList = CacheGetCollPtr(&C, &Info->LineInfoById);
+   }
+   for (I = 0; I < CollCount(&Info->SymInfoById); ++I) {
+      SymInfo *S = CollAt(&Info->SymInfoById, I);
+      S->Exp.Info = CacheGetItem(&C, &Info->SymInfoById);
+      S->Seg.Info = CacheGetItem(&C, &Info->SegInfoById);
+      S->Scope.Info = CacheGetItem(&C, &Info->ScopeInfoById);
+      S->Parent.Info = CacheGetItem(&C, &Info->SymInfoById);
+      S->CSym = CacheGetItem(&C, &Info->CSymInfoById);
+      S->ImportList = CacheGetCollPtr(&C, &Info->SymInfoById);
+      S->CheapLocals = CacheGetCollPtr(&C, &Info->SymInfoById);
+      CacheGetColl(&C, &S->DefLineInfoList, &Info->LineInfoById);
+      CacheGetColl(&C, &S->RefLineInfoList, &Info->LineInfoById);
+   }
+
+   // Global sorted collections
+   CacheGetColl(&C, &Info->CSymFuncByName, &Info->CSymInfoById);
+   CacheGetColl(&C, &Info->FileInfoByName, &Info->FileInfoById);
+   CacheGetColl(&C, &Info->ModInfoByName, &Info->ModInfoById);
+   CacheGetColl(&C, &Info->ScopeInfoByName, &Info->ScopeInfoById);
+   CacheGetColl(&C, &Info->SegInfoByName, &Info->SegInfoById);
+   CacheGetColl(&C, &Info->SymInfoByName, &Info->SymInfoById);
+   CacheGetColl(&C, &Info->SymInfoByVal, &Info->SymInfoById);
+   CollectLabels(&Info->LabelInfoByVal, &Info->SymInfoByVal);
+   Count = CacheGetCount(&C);
+   Info->SpanInfoByAddr.List =
+       xmalloc(Count * sizeof(Info->SpanInfoByAddr.List[0]));
+   for (I = 0; I < Count && !C.Error; ++I) {
+      SpanInfoListEntry *E = &Info->SpanInfoByAddr.List[I];
+      E->Addr = CacheGet(&C);
+      E->Count = CacheGetCount(&C);
+      if (E->Count == 0) {
+         C.Error = 1;
+         break;
+      }
+      else if (E->Count == 1) {
+         E->Data = CacheGetItem(&C, &Info->SpanInfoById);
+      }
+      else {
+         SpanInfo **Spans = xmalloc(E->Count * sizeof(Spans[0]));
+         for (J = 0; J < E->Count; ++J) {
+            Spans[J] = CacheGetItem(&C, &Info->SpanInfoById);
+         }
+         E->Data = Spans;
+      }
+      ++Info->SpanInfoByAddr.Count;
+   }
+
+   // The cache must end with the magic number
+   if (CacheGet(&C) != CACHE_MAGIC || C.Pos != C.Count) {
+      C.Error = 1;
+   }
+   FreeFileData(&Cache);
+
+   // Discard the cache if it is invalid
+   if (C.Error) {
+      FreeDbgInfo(Info);
+      return 0;
+   }
+
+   // The address map isn't cached, since it is created from the span info
+   // list
+   CreateAddrMap(&Info->AddrMap, &Info->SpanInfoByAddr);
+   return Info;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -5267,7 +6364,10 @@ cc65_dbginfo cc65_read_dbginfo(const char *FileName, cc65_errorfunc ErrFunc)
        0,                  // Line at start of current token
        0,                  // Column at start of current token
        0,                  // Number of errors
-       0,                  // Input file
+       0,                  // Number of warnings
+       0,                  // Contents of the input file
+       0,                  // Size of the input file
+       0,                  // Position in the input file
        ' ',                // Input character
        TOK_INVALID,        // Input token
        0,                  // Integer constant
@@ -5275,17 +6375,29 @@ cc65_dbginfo cc65_read_dbginfo(const char *FileName, cc65_errorfunc ErrFunc)
        0,                  // Function called in case of errors
        0,                  // Pointer to debug info
    };
+   FileData F;
+   uint64_t Hash;
+
    D.FileName = FileName;
    D.Error = ErrFunc;
 
-   // Open the input file
-   D.F = fopen(FileName, "rt");
-   if (D.F == 0) {
+   // Read the input file
+   if (ReadFileData(&F, FileName) != 0) {
       // Cannot open
       ParseError(&D, CC65_ERROR, "Cannot open input file \"%s\": %s", FileName,
                  strerror(errno));
       return 0;
    }
+   D.Buf = F.Data;
+   D.Size = F.Size;
+
+   // If the cache is up to date, use it instead of parsing the file
+   Hash = HashFileData(&F);
+   D.Info = ReadCache(FileName, F.Size, Hash);
+   if (D.Info) {
+      FreeFileData(&F);
+      return D.Info;
+   }
 
    // Create a new debug info struct
    D.Info = NewDbgInfo(FileName);
@@ -5400,8 +6512,8 @@ cc65_dbginfo cc65_read_dbginfo(const char *FileName, cc65_errorfunc ErrFunc)
    }
 
 CloseAndExit:
-   // Close the file
-   fclose(D.F);
+   // Free the file contents
+   FreeFileData(&F);
 
    // Free memory allocated for SVal
    SB_Done(&D.SVal);
@@ -5431,6 +6543,12 @@ CloseAndExit:
    DumpData(&D);
 #endif
 
+   // Write the cache, so the next load is faster. Files with errors or
+   // warnings are not cached, since the messages wouldn't be repeated.
+   if (D.Errors == 0 && D.Warnings == 0) {
+      WriteCache(D.Info, F.Size, Hash);
+   }
+
    // Return the debug info struct that was created
    return D.Info;
 }
@@ -6201,6 +7319,49 @@ void cc65_free_spaninfo(cc65_dbginfo Handle, const cc65_spaninfo *Info)
    xfree((cc65_spaninfo *)Info);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//                                 Addresses
+////////////////////////////////////////////////////////////////////////////////
+
+unsigned cc65_symbolize_addrs(cc65_dbginfo Handle, const cc65_addr *Addrs,
+                              unsigned Count, cc65_addrdata *Data)
+// Look up count addresses from addrs and store the innermost items for each
+// of them in data, which must have room for count entries. The function
+// returns the number of addresses that are contained in a span.
+{
+   const DbgInfo *Info;
+   unsigned Found = 0;
+   unsigned Last = 0;
+   unsigned I;
+
+   // Check the parameter
+   assert(Handle != 0);
+
+   // The handle is actually a pointer to a debug info struct
+   Info = Handle;
+
+   // Look up the addresses. The entry found last is remembered here and not
+   // in the handle, so the handle isn't modified.
+   for (I = 0; I < Count; ++I) {
+      const AddrMapEntry *E =
+          FindAddrMapEntry(&Info->AddrMap, Addrs[I], &Last);
+      if (E) {
+         Data[I].span_id = E->SpanId;
+         Data[I].line_id = E->LineId;
+         Data[I].scope_id = E->ScopeId;
+         ++Found;
+      }
+      else {
+         Data[I].span_id = CC65_INV_ID;
+         Data[I].line_id = CC65_INV_ID;
+         Data[I].scope_id = CC65_INV_ID;
+      }
+   }
+
+   // Return the number of addresses found
+   return Found;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                               Source files
 ////////////////////////////////////////////////////////////////////////////////
@@ -6759,10 +7920,10 @@ const cc65_symbolinfo *cc65_symbol_inrange(cc65_dbginfo Handle, cc65_addr Start,
 // symbols are ignored and not returned.
 {
    const DbgInfo *Info;
-   Collection SymInfoList = COLLECTION_INITIALIZER;
    cc65_symbolinfo *D;
    unsigned I;
    unsigned Index;
+   unsigned Count;
 
    // Check the parameter
    assert(Handle != 0);
@@ -6770,50 +7931,34 @@ const cc65_symbolinfo *cc65_symbol_inrange(cc65_dbginfo Handle, cc65_addr Start,
    // The handle is actually a pointer to a debug info struct
    Info = Handle;
 
-   // Search for the symbol. Because we're searching for a range, we cannot
-   // make use of the function result.
-   FindSymInfoByValue(&Info->SymInfoByVal, Start, &Index);
+   // Search for the first label. Because we're searching for a range, we
+   // cannot make use of the function result.
+   FindSymInfoByValue(&Info->LabelInfoByVal, Start, &Index);
 
-   // Start from the given index, check all symbols until the end address is
-   // reached. Place all symbols into SymInfoList for later.
-   for (I = Index; I < CollCount(&Info->SymInfoByVal); ++I) {
-
-      // Get the item
-      SymInfo *Item = CollAt(&Info->SymInfoByVal, I);
-
-      // The collection is sorted by address, so if we get a value larger
-      // than the end address, we're done.
+   // The collection contains only labels and is sorted by address, so the
+   // labels in the range follow each other. Count them.
+   for (I = Index; I < CollCount(&Info->LabelInfoByVal); ++I) {
+      const SymInfo *Item = CollAt(&Info->LabelInfoByVal, I);
       if (Item->Value > (long)End) {
          break;
       }
-
-      // Ignore non-labels (this will also ignore imports)
-      if (Item->Type != CC65_SYM_LABEL) {
-         continue;
-      }
-
-      // Ok, remember this one
-      CollAppend(&SymInfoList, Item);
    }
+   Count = I - Index;
 
-   // If we don't have any labels within the range, bail out. No memory has
-   // been allocated for SymInfoList.
-   if (CollCount(&SymInfoList) == 0) {
+   // If we don't have any labels within the range, bail out
+   if (Count == 0) {
       return 0;
    }
 
    // Allocate memory for the data structure returned to the caller
-   D = new_cc65_symbolinfo(CollCount(&SymInfoList));
+   D = new_cc65_symbolinfo(Count);
 
    // Fill in the data
-   for (I = 0; I < CollCount(&SymInfoList); ++I) {
+   for (I = 0; I < Count; ++I) {
       // Copy the data
-      CopySymInfo(D->data + I, CollAt(&SymInfoList, I));
+      CopySymInfo(D->data + I, CollAt(&Info->LabelInfoByVal, Index + I));
    }
 
-   // Free the collection
-   CollDone(&SymInfoList);
-
    // Return the result
    return D;
 }
@@ -320,6 +320,34 @@ const cc65_spaninfo *cc65_span_byscope(cc65_dbginfo handle, unsigned scope_id);
 void cc65_free_spaninfo(cc65_dbginfo handle, const cc65_spaninfo *info);
 // Free a span info record
 
+////////////////////////////////////////////////////////////////////////////////
+//                                 Addresses
+////////////////////////////////////////////////////////////////////////////////
+
+// The innermost items for an address. Ids are CC65_INV_ID if there is no
+// such item for the address.
+// Notes:
+// - line_id is the line of the smallest span that has lines. C source lines
+// are preferred over assembler lines, and both over macro lines, so for a
+// C program, the C source line is returned.
+// - scope_id is the innermost scope of the smallest span that has scopes.
+typedef struct cc65_addrdata cc65_addrdata;
+struct cc65_addrdata {
+   unsigned span_id;  // Smallest span containing the address
+   unsigned line_id;  // Line for the address
+   unsigned scope_id; // Scope for the address
+};
+
+unsigned cc65_symbolize_addrs(cc65_dbginfo handle, const cc65_addr *addrs,
+                              unsigned count, cc65_addrdata *data);
+// Look up count addresses from addrs and store the innermost items for each
+// of them in data, which must have room for count entries. The function
+// returns the number of addresses that are contained in a span. It doesn't
+// allocate memory per call, so it is the preferred way to look up many
+// addresses, for example in profilers and trace decoders. Lookups are
+// fastest if consecutive addresses are close to each other. The handle isn't
+// modified, so several threads may look up addresses at the same time.
+
 ////////////////////////////////////////////////////////////////////////////////
 //                               Source files
 ////////////////////////////////////////////////////////////////////////////////
@@ -43,6 +43,7 @@
 #include "chartype.h"
 #include "cmdline.h"
 #include "coll.h"
+#include "xmalloc.h"
 
 // dbginfo
 #include "dbginfo.h"
@@ -66,6 +67,9 @@ static void CmdShow(Collection *Args);
 static void CmdShowHelp(Collection *Args);
 // Print help for the show command
 
+static void CmdShowAddress(Collection *Args);
+// Show the innermost items for addresses from the debug info file
+
 static void CmdShowChildScopes(Collection *Args);
 // Show child scopes from the debug info file
 
@@ -161,6 +165,9 @@ static const CmdEntry MainCmds[] = {
 
 // Table with show commands
 static const CmdEntry ShowCmds[] = {
+    {"address",
+     "Show the innermost span, line and scope for one or more addresses.", -2,
+     CmdShowAddress},
     {"childscopes", "Show child scopes of other scopes.", -2,
      CmdShowChildScopes},
     {"csym", 0, -1, CmdShowCSymbol},
@@ -381,6 +388,22 @@ static int GetId(const char *S, unsigned *Id, unsigned *IdType)
    return 0;
 }
 
+static int GetAddr(const char *S, cc65_addr *Addr)
+// Parse a string for an address, which may be decimal, or hex with a leading
+// '$' or "0x". If a valid address is found, it is placed in Addr and the
+// function returns true, otherwise it returns false.
+{
+   char *End;
+   if (*S == '$') {
+      ++S;
+      *Addr = (cc65_addr)strtoul(S, &End, 16);
+   }
+   else {
+      *Addr = (cc65_addr)strtoul(S, &End, 0);
+   }
+   return (End != S && *End == '\0');
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                      Output functions for item lists
 ////////////////////////////////////////////////////////////////////////////////
@@ -834,6 +857,46 @@ static void CmdShowHelp(Collection *Args attribute((unused)))
    PrintHelp(ShowCmds, sizeof(ShowCmds) / sizeof(ShowCmds[0]));
 }
 
+static void CmdShowAddress(Collection *Args)
+// Show the innermost items for addresses from the debug info file
+{
+   cc65_addr *Addrs;
+   cc65_addrdata *Data;
+   unsigned Count = 0;
+   unsigned I;
+
+   // Be sure a file is loaded
+   if (!FileIsLoaded()) {
+      return;
+   }
+
+   // Parse the arguments, ignoring invalid addresses
+   Addrs = xmalloc(CollCount(Args) * sizeof(Addrs[0]));
+   for (I = 0; I < CollCount(Args); ++I) {
+      if (GetAddr(CollConstAt(Args, I), &Addrs[Count])) {
+         ++Count;
+      }
+   }
+
+   // Look up all addresses in one call
+   Data = xmalloc(CollCount(Args) * sizeof(Data[0]));
+   cc65_symbolize_addrs(Info, Addrs, Count, Data);
+
+   // Output the list
+   PrintLine("  addr   span   line  scope");
+   PrintSeparator();
+   for (I = 0; I < Count; ++I) {
+      PrintAddr(Addrs[I], 9);
+      PrintId(Data[I].span_id, 7);
+      PrintId(Data[I].line_id, 7);
+      PrintId(Data[I].scope_id, 0);
+      NewLine();
+   }
+
+   xfree(Data);
+   xfree(Addrs);
+}
+
 static void CmdShowChildScopes(Collection *Args)
 // Show child scopes from the debug info file
 {
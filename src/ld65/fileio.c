@@ -35,6 +35,7 @@
 #include <errno.h>
 
 // common
+#include "filestat.h"
 #include "xmalloc.h"
 
 // ld65
@@ -42,6 +43,15 @@
 #include "fileio.h"
 #include "spool.h"
 
+////////////////////////////////////////////////////////////////////////////////
+//                                   Data
+////////////////////////////////////////////////////////////////////////////////
+
+// Upper limit for the stdio buffer of an input file. Libraries in a group
+// stay open together, so the limit must be small enough that many open files
+// don't add up. Most object files still fit completely.
+#define MAX_FILE_BUF (64UL * 1024UL)
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                   Code
 ////////////////////////////////////////////////////////////////////////////////
@@ -54,6 +64,22 @@ void FileSetPos(FILE *F, unsigned long Pos)
    }
 }
 
+void FileSetBuf(FILE *F, const char *Name)
+// Give an input file that was just opened a stdio buffer large enough to
+// hold the complete file, but not more than MAX_FILE_BUF. Must be called
+// before any other operation on the stream. Failures are ignored since the
+// stream remains usable with its default buffer.
+{
+   struct stat StatBuf;
+   if (FileStat(Name, &StatBuf) == 0 && StatBuf.st_size > BUFSIZ) {
+      size_t Size = StatBuf.st_size;
+      if (Size > MAX_FILE_BUF) {
+         Size = MAX_FILE_BUF;
+      }
+      setvbuf(F, 0, _IOFBF, Size);
+   }
+}
+
 unsigned long FileGetPos(FILE *F)
 // Return the current file position, fail on errors
 {
@@ -46,6 +46,11 @@
 void FileSetPos(FILE *F, unsigned long Pos);
 // Seek to the given absolute position, fail on errors
 
+void FileSetBuf(FILE *F, const char *Name);
+// Give an input file that was just opened a stdio buffer large enough to
+// hold the complete file, but not more than a small limit. Must be called
+// before any other operation on the stream.
+
 unsigned long FileGetPos(FILE *F);
 // Return the current file position, fail on errors
 
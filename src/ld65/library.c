@@ -137,7 +137,8 @@ static void LibReadHeader(Library *L)
    // Read the remaining header fields (magic is already read)
    L->Header.Magic = LIB_MAGIC;
    L->Header.Version = Read16(L->F);
-   if (L->Header.Version != LIB_VERSION) {
+   if (L->Header.Version != LIB_VERSION &&
+       L->Header.Version != LIB_VERSION_NOEXPORTS) {
       Error("Wrong data version in '%s'", GetString(L->Name));
    }
    L->Header.Flags = Read16(L->F);
@@ -200,6 +201,17 @@ static ObjData *ReadIndexEntry(Library *L)
    O->Start = Read32(L->F);
    Read32(L->F); // Skip Size
 
+   // Names of the exports. They are used to decide if the module is needed,
+   // so the module data has to be read only for modules that are linked.
+   if (L->Header.Version != LIB_VERSION_NOEXPORTS) {
+      unsigned I;
+      O->LibExpCount = ReadVar(L->F);
+      O->LibExpNames = xmalloc(O->LibExpCount * sizeof(O->LibExpNames[0]));
+      for (I = 0; I < O->LibExpCount; ++I) {
+         O->LibExpNames[I] = ReadStr(L->F);
+      }
+   }
+
    // Done
    return O;
 }
@@ -226,6 +238,9 @@ static void ReadBasicData(Library *L, ObjData *O)
 
    // Read the exports
    ObjReadExports(L->F, O->Start + O->Header.ExportOffs, O);
+
+   // Remember that we have the data
+   O->Flags |= OBJ_BASIC;
 }
 
 static void LibReadIndex(Library *L)
@@ -245,8 +260,11 @@ static void LibReadIndex(Library *L)
       CollAppend(&L->Modules, ReadIndexEntry(L));
    }
 
-   // Walk over the index and read basic data for all object files in the
-   // library.
+   // Old libraries don't have the export names in the index. Walk over the
+   // index and read basic data for all object files in the library.
+   if (L->Header.Version != LIB_VERSION_NOEXPORTS) {
+      return;
+   }
    for (I = 0; I < CollCount(&L->Modules); ++I) {
       ReadBasicData(L, CollAtUnchecked(&L->Modules, I));
    }
@@ -262,6 +280,20 @@ static void LibCheckExports(ObjData *O)
 {
    unsigned I;
 
+   // If the basic data wasn't read, use the export names from the index and
+   // read the data only if the module is actually needed.
+   if ((O->Flags & OBJ_BASIC) == 0) {
+      for (I = 0; I < O->LibExpCount; ++I) {
+         if (IsUnresolved(O->LibExpNames[I])) {
+            break;
+         }
+      }
+      if (I >= O->LibExpCount) {
+         return;
+      }
+      ReadBasicData(O->Lib, O);
+   }
+
    // Check all exports
    for (I = 0; I < CollCount(&O->Exports); ++I) {
       const Export *E = CollConstAt(&O->Exports, I);
@@ -81,14 +81,14 @@ static unsigned LibFiles = 0; // Count of library files linked
 #define INPUT_FILES_SGROUP 3   // Entry is 'StartGroup'
 #define INPUT_FILES_EGROUP 4   // Entry is 'EndGroup'
 
-#define MAX_INPUTFILES 256
-
-// Array of inputs (libraries and object files)
+// Array of inputs (libraries and object files). The array grows as needed,
+// so the number of input files is limited only by the command line.
 static struct InputFile {
    const char *FileName;
    unsigned Type;
 } *InputFiles;
 static unsigned InputFilesCount = 0;
+static unsigned InputFilesMax = 0;
 static const char *CmdlineCfgFile = NULL, *CmdlineTarget = NULL;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -164,6 +164,21 @@ static unsigned long CvtNumber(const char *Arg, const char *Number)
    return Val;
 }
 
+static void AddInputFile(unsigned Type, const char *Name)
+// Remember an input file (or group marker) for processing after all options
+// have been parsed.
+{
+   // Grow the array if necessary
+   if (InputFilesCount == InputFilesMax) {
+      InputFilesMax = InputFilesMax ? InputFilesMax * 2 : 64;
+      InputFiles =
+          xrealloc(InputFiles, InputFilesMax * sizeof(struct InputFile));
+   }
+   InputFiles[InputFilesCount].Type = Type;
+   InputFiles[InputFilesCount].FileName = Name;
+   ++InputFilesCount;
+}
+
 static void LinkFile(const char *Name, FILETYPE Type)
 // Handle one file
 {
@@ -209,6 +224,12 @@ static void LinkFile(const char *Name, FILETYPE Type)
       Error("Cannot open '%s': %s", PathName, strerror(errno));
    }
 
+   // Object files and library modules are decoded section by section with
+   // a seek before each section. Buffer small files completely, so the
+   // decode phase is served from memory instead of refilling the stdio
+   // buffer after every seek.
+   FileSetBuf(F, PathName);
+
    // Read the magic word
    Magic = Read32(F);
 
@@ -381,10 +402,7 @@ static void OptLargeAlignment(const char *Opt attribute((unused)),
 static void OptLib(const char *Opt attribute((unused)), const char *Arg)
 // Link a library
 {
-   InputFiles[InputFilesCount].Type = INPUT_FILES_FILE_LIB;
-   InputFiles[InputFilesCount].FileName = Arg;
-   if (++InputFilesCount >= MAX_INPUTFILES)
-      Error("Too many input files");
+   AddInputFile(INPUT_FILES_FILE_LIB, Arg);
 }
 
 static void OptLibPath(const char *Opt attribute((unused)), const char *Arg)
@@ -415,10 +433,7 @@ static void OptModuleId(const char *Opt, const char *Arg)
 static void OptObj(const char *Opt attribute((unused)), const char *Arg)
 // Link an object file
 {
-   InputFiles[InputFilesCount].Type = INPUT_FILES_FILE_OBJ;
-   InputFiles[InputFilesCount].FileName = Arg;
-   if (++InputFilesCount >= MAX_INPUTFILES)
-      Error("Too many input files");
+   AddInputFile(INPUT_FILES_FILE_OBJ, Arg);
 }
 
 static void OptObjPath(const char *Opt attribute((unused)), const char *Arg)
@@ -518,20 +533,14 @@ static void CmdlOptStartGroup(const char *Opt attribute((unused)),
                               const char *Arg attribute((unused)))
 // Remember 'start group' occurrence in input files array
 {
-   InputFiles[InputFilesCount].Type = INPUT_FILES_SGROUP;
-   InputFiles[InputFilesCount].FileName = Arg; // Unused
-   if (++InputFilesCount >= MAX_INPUTFILES)
-      Error("Too many input files");
+   AddInputFile(INPUT_FILES_SGROUP, Arg);
 }
 
 static void CmdlOptEndGroup(const char *Opt attribute((unused)),
                             const char *Arg attribute((unused)))
 // Remember 'end group' occurrence in input files array
 {
-   InputFiles[InputFilesCount].Type = INPUT_FILES_EGROUP;
-   InputFiles[InputFilesCount].FileName = Arg; // Unused
-   if (++InputFilesCount >= MAX_INPUTFILES)
-      Error("Too many input files");
+   AddInputFile(INPUT_FILES_EGROUP, Arg);
 }
 
 static void CmdlOptConfig(const char *Opt attribute((unused)), const char *Arg)
@@ -580,9 +589,6 @@ static void ParseCommandLine(void) {
    unsigned I;
    unsigned LabelFileGiven = 0;
 
-   // Allocate memory for input file array
-   InputFiles = xmalloc(MAX_INPUTFILES * sizeof(struct InputFile));
-
    // Defer setting of config/target and input files until all options are
    // parsed
    I = 1;
@@ -683,10 +689,7 @@ static void ParseCommandLine(void) {
       else {
 
          // A filename
-         InputFiles[InputFilesCount].Type = INPUT_FILES_FILE;
-         InputFiles[InputFilesCount].FileName = Arg;
-         if (++InputFilesCount >= MAX_INPUTFILES)
-            Error("Too many input files");
+         AddInputFile(INPUT_FILES_FILE, Arg);
       }
 
       // Next argument
@@ -82,6 +82,8 @@ ObjData *NewObjData(void)
    O->LineInfos = EmptyCollection;
    O->StringCount = 0;
    O->Strings = 0;
+   O->LibExpCount = 0;
+   O->LibExpNames = 0;
    O->Assertions = EmptyCollection;
    O->Scopes = EmptyCollection;
    O->Spans = EmptyCollection;
@@ -118,6 +120,7 @@ void FreeObjData(ObjData *O)
    }
    DoneCollection(&O->LineInfos);
    xfree(O->Strings);
+   xfree(O->LibExpNames);
    DoneCollection(&O->Assertions);
    DoneCollection(&O->Scopes);
    for (I = 0; I < CollCount(&O->Spans); ++I) {
@@ -134,6 +137,9 @@ void FreeObjStrings(ObjData *O)
 {
    xfree(O->Strings);
    O->Strings = 0;
+   xfree(O->LibExpNames);
+   O->LibExpNames = 0;
+   O->LibExpCount = 0;
 }
 
 void InsertObjData(ObjData *O)
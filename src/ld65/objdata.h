@@ -52,7 +52,8 @@ struct Section;
 struct StrBuf;
 
 // Values for the Flags field
-#define OBJ_REF 0x0001 // We have a reference to this file
+#define OBJ_REF 0x0001   // We have a reference to this file
+#define OBJ_BASIC 0x0002 // Basic data of a library module was read
 
 // Internal structure holding object file data
 typedef struct ObjData ObjData;
@@ -80,6 +81,8 @@ struct ObjData {
    Collection LineInfos;  // List of line infos
    unsigned StringCount;  // Count of strings
    unsigned *Strings;     // List of global string indices
+   unsigned LibExpCount;  // Count of export names from library index
+   unsigned *LibExpNames; // Export names from library index
    Collection Assertions; // List of module assertions
    Collection Scopes;     // List of scopes
    Collection Spans;      // List of spans
@@ -50,6 +50,7 @@
 #include "paravirt.h"
 #include "trace.h"
 #include "profile.h"
+#include "coverage.h"
 
 #include "6502.h"
 
@@ -3543,6 +3544,12 @@ void IRQRequest(void)
    HaveIRQRequest = true;
 }
 
+void IRQClear(void)
+// Withdraw a pending IRQ request
+{
+   HaveIRQRequest = false;
+}
+
 void NMIRequest(void)
 // Generate an NMI
 {
@@ -3611,7 +3618,8 @@ unsigned ExecuteInsn(void)
    else {
 
       // Normal instruction - read the next opcode
-      uint8_t OPC = MemReadByte(Regs.PC);
+      uint16_t PC = Regs.PC;
+      uint8_t OPC = MemReadByte(PC);
 
       // Print a trace line, if trace mode is enabled.
       if (TraceMode != TRACE_DISABLED) {
@@ -3621,8 +3629,19 @@ unsigned ExecuteInsn(void)
       // Increment the instruction counter by one.
       Peripherals.Counter.CpuInstructions += 1;
 
+      // Count the instruction for the coverage report and heatmap. This is
+      // done before executing it, because the program may exit within.
+      if (enableCoverage) {
+         CoverageCount(PC);
+      }
+
       // Execute the instruction. The handler sets the 'Cycles' variable.
       Handlers[CPU][OPC]();
+
+      // Record the cycles and the branch outcome of the instruction
+      if (enableCoverage) {
+         CoverageRecord(PC, OPC, Regs.PC, Cycles);
+      }
    }
 
    // Increment the 64-bit clock cycle counter with the cycle count for the
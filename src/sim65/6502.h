@@ -79,6 +79,9 @@ void Reset(void);
 void IRQRequest(void);
 // Generate an IRQ
 
+void IRQClear(void);
+// Withdraw a pending IRQ request
+
 void NMIRequest(void);
 // Generate an NMI
 
@@ -0,0 +1,368 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//                                coverage.c
+//
+//           Code coverage and heatmap recording for the sim65 simulator
+//
+//
+//
+// (C) 2026, The cc65 Authors
+//
+//
+// This software is provided 'as-is', without any expressed or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+// common
+#include "xmalloc.h"
+
+// dbginfo
+#include "../dbginfo/dbginfo.h"
+
+// sim65
+#include "6502.h"
+#include "coverage.h"
+#include "error.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//                                   Data
+////////////////////////////////////////////////////////////////////////////////
+
+bool enableCoverage = false;
+const char *coverageFile = NULL;
+const char *heatmapFile = NULL;
+const char *coverageDbgFile = NULL;
+
+// Bitmaps with one bit per address: The instruction at the address was
+// executed, or the branch at the address was taken or not taken.
+static uint8_t Executed[0x10000 / 8];
+static uint8_t Taken[0x10000 / 8];
+static uint8_t NotTaken[0x10000 / 8];
+
+// Heatmap: Execution count and clock cycles per instruction address
+static uint32_t ExecCount[0x10000];
+static uint64_t CycleCount[0x10000];
+
+#define SET_BIT(Map, Addr) ((Map)[(Addr) >> 3] |= (uint8_t)(1U << ((Addr) & 7)))
+#define GET_BIT(Map, Addr) (((Map)[(Addr) >> 3] >> ((Addr) & 7)) & 1)
+
+// A source line for the lcov report
+typedef struct LineEntry {
+   unsigned Source;
+   unsigned Line;
+   uint32_t Count;
+} LineEntry;
+
+// A branch instruction for the lcov report
+typedef struct BranchEntry {
+   unsigned Source;
+   unsigned Line;
+   unsigned Addr;
+} BranchEntry;
+
+static LineEntry *Lines = NULL;
+static unsigned LineCount = 0;
+static BranchEntry *Branches = NULL;
+static unsigned BranchCount = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+//                                   Code
+////////////////////////////////////////////////////////////////////////////////
+
+static unsigned BranchSize(uint8_t OPC)
+// Return the size of the instruction if OPC is a conditional branch, or zero
+{
+   if ((OPC & 0x1F) == 0x10) {
+      // BPL, BMI, BVC, BVS, BCC, BCS, BNE, BEQ
+      return 2;
+   }
+   else if (CPU == CPU_65C02 && (OPC & 0x0F) == 0x0F) {
+      // BBR and BBS
+      return 3;
+   }
+   return 0;
+}
+
+void CoverageCount(uint16_t PC)
+// Count the execution of the instruction at PC, before it is executed
+{
+   SET_BIT(Executed, PC);
+   ++ExecCount[PC];
+}
+
+void CoverageRecord(uint16_t PC, uint8_t OPC, uint16_t NextPC,
+                    unsigned Cycles)
+// Record the cycles and the branch outcome of the instruction at PC
+{
+   unsigned Size;
+
+   CycleCount[PC] += Cycles;
+
+   // For conditional branches, remember the outcome. A branch with an offset
+   // of zero is counted as not taken.
+   if ((Size = BranchSize(OPC)) != 0) {
+      if (NextPC == (uint16_t)(PC + Size)) {
+         SET_BIT(NotTaken, PC);
+      }
+      else {
+         SET_BIT(Taken, PC);
+      }
+   }
+}
+
+static void AddLine(unsigned Source, unsigned Line, uint32_t Count) {
+   if ((LineCount & 0xFF) == 0) {
+      Lines = xrealloc(Lines, (LineCount + 0x100) * sizeof(LineEntry));
+   }
+   Lines[LineCount].Source = Source;
+   Lines[LineCount].Line = Line;
+   Lines[LineCount].Count = Count;
+   ++LineCount;
+}
+
+static void AddBranch(unsigned Source, unsigned Line, unsigned Addr) {
+   if ((BranchCount & 0xFF) == 0) {
+      Branches =
+          xrealloc(Branches, (BranchCount + 0x100) * sizeof(BranchEntry));
+   }
+   Branches[BranchCount].Source = Source;
+   Branches[BranchCount].Line = Line;
+   Branches[BranchCount].Addr = Addr;
+   ++BranchCount;
+}
+
+static int CompareLine(const void *a, const void *b) {
+   const LineEntry *pa = (const LineEntry *)a;
+   const LineEntry *pb = (const LineEntry *)b;
+
+   if (pa->Source != pb->Source) {
+      return pa->Source < pb->Source ? -1 : 1;
+   }
+   if (pa->Line != pb->Line) {
+      return pa->Line < pb->Line ? -1 : 1;
+   }
+   return 0;
+}
+
+static int CompareBranch(const void *a, const void *b) {
+   const BranchEntry *pa = (const BranchEntry *)a;
+   const BranchEntry *pb = (const BranchEntry *)b;
+
+   if (pa->Source != pb->Source) {
+      return pa->Source < pb->Source ? -1 : 1;
+   }
+   if (pa->Line != pb->Line) {
+      return pa->Line < pb->Line ? -1 : 1;
+   }
+   return (int)pa->Addr - (int)pb->Addr;
+}
+
+static bool IsCodeSegment(cc65_dbginfo Info, unsigned Id)
+// Return true if the segment contains code. Only lines in code segments are
+// reported, since data is never executed.
+{
+   bool Result = false;
+   const cc65_segmentinfo *S = cc65_segment_byid(Info, Id);
+
+   if (S) {
+      const char *Name = S->data[0].segment_name;
+      Result = strstr(Name, "CODE") != 0 || strcmp(Name, "STARTUP") == 0 ||
+               strcmp(Name, "ONCE") == 0;
+      cc65_free_segmentinfo(Info, S);
+   }
+   return Result;
+}
+
+static void CollectLines(cc65_dbginfo Info)
+// Collect the lines and branches of all code spans
+{
+   unsigned I, J;
+   const cc65_spaninfo *Spans = cc65_get_spanlist(Info);
+
+   if (!Spans) {
+      return;
+   }
+
+   for (I = 0; I < Spans->count; ++I) {
+      const cc65_spandata *S = &Spans->data[I];
+      const cc65_lineinfo *L;
+      uint32_t Count = 0;
+      unsigned Addr;
+
+      if (S->line_count == 0 || S->span_end > 0xFFFF ||
+          !IsCodeSegment(Info, S->segment_id)) {
+         continue;
+      }
+
+      // A line counts as executed as often as its most executed instruction
+      for (Addr = S->span_start; Addr <= S->span_end; ++Addr) {
+         if (ExecCount[Addr] > Count) {
+            Count = ExecCount[Addr];
+         }
+      }
+
+      L = cc65_line_byspan(Info, S->span_id);
+      if (!L) {
+         continue;
+      }
+      for (J = 0; J < L->count; ++J) {
+         const cc65_linedata *D = &L->data[J];
+         if (D->line_type == CC65_LINE_MACRO) {
+            continue;
+         }
+         AddLine(D->source_id, D->source_line, Count);
+         for (Addr = S->span_start; Addr <= S->span_end; ++Addr) {
+            if (GET_BIT(Taken, Addr) || GET_BIT(NotTaken, Addr)) {
+               AddBranch(D->source_id, D->source_line, Addr);
+            }
+         }
+      }
+      cc65_free_lineinfo(Info, L);
+   }
+
+   cc65_free_spaninfo(Info, Spans);
+}
+
+static void WriteLcov(cc65_dbginfo Info, FILE *F)
+// Write the collected lines and branches in lcov format
+{
+   unsigned I = 0, J = 0;
+
+   qsort(Lines, LineCount, sizeof(LineEntry), CompareLine);
+   qsort(Branches, BranchCount, sizeof(BranchEntry), CompareBranch);
+
+   fprintf(F, "TN:\n");
+   while (I < LineCount) {
+      unsigned Source = Lines[I].Source;
+      unsigned Found = 0, Hit = 0, BrFound = 0, BrHit = 0;
+      const cc65_sourceinfo *SI = cc65_source_byid(Info, Source);
+
+      fprintf(F, "SF:%s\n", SI ? SI->data[0].source_name : "???");
+      if (SI) {
+         cc65_free_sourceinfo(Info, SI);
+      }
+
+      // Lines of this source, merging duplicates
+      while (I < LineCount && Lines[I].Source == Source) {
+         unsigned Line = Lines[I].Line;
+         uint32_t Count = 0;
+         while (I < LineCount && Lines[I].Source == Source &&
+                Lines[I].Line == Line) {
+            if (Lines[I].Count > Count) {
+               Count = Lines[I].Count;
+            }
+            ++I;
+         }
+         fprintf(F, "DA:%u,%" PRIu32 "\n", Line, Count);
+         ++Found;
+         if (Count) {
+            ++Hit;
+         }
+      }
+
+      // Branches of this source. The address is used as block number.
+      while (J < BranchCount && Branches[J].Source < Source) {
+         ++J;
+      }
+      while (J < BranchCount && Branches[J].Source == Source) {
+         const BranchEntry *B = &Branches[J++];
+         if (J < BranchCount && CompareBranch(B, &Branches[J]) == 0) {
+            continue;
+         }
+         fprintf(F, "BRDA:%u,%u,0,%u\n", B->Line, B->Addr,
+                 GET_BIT(Taken, B->Addr));
+         fprintf(F, "BRDA:%u,%u,1,%u\n", B->Line, B->Addr,
+                 GET_BIT(NotTaken, B->Addr));
+         BrFound += 2;
+         BrHit += GET_BIT(Taken, B->Addr) + GET_BIT(NotTaken, B->Addr);
+      }
+
+      if (BrFound) {
+         fprintf(F, "BRF:%u\nBRH:%u\n", BrFound, BrHit);
+      }
+      fprintf(F, "LF:%u\nLH:%u\n", Found, Hit);
+      fprintf(F, "end_of_record\n");
+   }
+}
+
+static void WriteHeatmap(FILE *F)
+// Write execution count and clock cycles of all executed addresses
+{
+   unsigned Addr;
+
+   fprintf(F, "# addr count cycles\n");
+   for (Addr = 0; Addr < 0x10000; ++Addr) {
+      if (GET_BIT(Executed, Addr)) {
+         fprintf(F, "%04X %10" PRIu32 " %12" PRIu64 "\n", Addr,
+                 ExecCount[Addr], CycleCount[Addr]);
+      }
+   }
+}
+
+static void DbgError(const cc65_parseerror *E) {
+   fprintf(stderr, "%s:%u: %s: %s\n", E->name, E->line,
+           E->type == CC65_WARNING ? "Warning" : "Error", E->errormsg);
+}
+
+static void CoverageDump(void) {
+   FILE *F;
+
+   if (heatmapFile) {
+      if ((F = fopen(heatmapFile, "w")) != 0) {
+         WriteHeatmap(F);
+         fclose(F);
+      }
+      else {
+         Warning("Cannot create heatmap file '%s'", heatmapFile);
+      }
+   }
+
+   if (coverageFile) {
+      cc65_dbginfo Info = cc65_read_dbginfo(coverageDbgFile, DbgError);
+      if (!Info) {
+         Warning("Cannot read debug info file '%s'", coverageDbgFile);
+         return;
+      }
+      CollectLines(Info);
+      if ((F = fopen(coverageFile, "w")) != 0) {
+         WriteLcov(Info, F);
+         fclose(F);
+      }
+      else {
+         Warning("Cannot create coverage file '%s'", coverageFile);
+      }
+      cc65_free_dbginfo(Info);
+   }
+}
+
+void CoverageInit(void)
+// Initialize coverage recording after the command line has been parsed
+{
+   if (coverageFile && !coverageDbgFile) {
+      Error("--coverage needs a debug info file (--dbgfile)");
+   }
+   enableCoverage = (coverageFile != NULL || heatmapFile != NULL);
+   if (enableCoverage) {
+      atexit(CoverageDump);
+   }
+}
@@ -0,0 +1,61 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+//                                coverage.h
+//
+//           Code coverage and heatmap recording for the sim65 simulator
+//
+//
+//
+// (C) 2026, The cc65 Authors
+//
+//
+// This software is provided 'as-is', without any expressed or implied
+// warranty.  In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef COVERAGE_H
+#define COVERAGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern bool enableCoverage;
+// true if executed instructions are recorded
+
+extern const char *coverageFile;
+// lcov file written at exit, or NULL
+
+extern const char *heatmapFile;
+// Heatmap file written at exit, or NULL
+
+extern const char *coverageDbgFile;
+// Debug info file used to map addresses to source lines, or NULL
+
+void CoverageInit(void);
+// Initialize coverage recording after the command line has been parsed
+
+void CoverageCount(uint16_t PC);
+// Count the execution of the instruction at PC, before it is executed
+
+void CoverageRecord(uint16_t PC, uint8_t OPC, uint16_t NextPC,
+                    unsigned Cycles);
+// Record the cycles and the branch outcome of the instruction at PC
+
+// End of coverage.h
+
+#endif
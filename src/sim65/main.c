@@ -50,6 +50,7 @@
 #include "paravirt.h"
 #include "trace.h"
 #include "profile.h"
+#include "coverage.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 //                                   Data
@@ -91,8 +92,11 @@ static void Usage(void) {
           "\n"
           "Long options:\n"
           "  --help\t\tHelp (this text)\n"
+          "  --coverage <file>\tWrite an lcov coverage report\n"
           "  --cycles\t\tPrint amount of executed CPU cycles\n"
           "  --cpu <type>\t\tOverride CPU type (6502, 65C02, 6502X)\n"
+          "  --dbgfile <file>\tDebug info file for the coverage report\n"
+          "  --heatmap <file>\tWrite execution counts per address\n"
           "  --trace\t\tEnable CPU trace\n"
           "  --profile <mapfile>\t\tEnable profiler\n"
           "  --verbose\t\tIncrease verbosity\n"
@@ -157,6 +161,24 @@ static void OptProfile(const char *Opt attribute((unused)), const char *Arg)
    symInfoFile = strdup(Arg);
 }
 
+static void OptCoverage(const char *Opt attribute((unused)), const char *Arg)
+// Write an lcov coverage report at the end
+{
+   coverageFile = strdup(Arg);
+}
+
+static void OptDbgFile(const char *Opt attribute((unused)), const char *Arg)
+// Set the debug info file for the coverage report
+{
+   coverageDbgFile = strdup(Arg);
+}
+
+static void OptHeatmap(const char *Opt attribute((unused)), const char *Arg)
+// Write the execution counts per address at the end
+{
+   heatmapFile = strdup(Arg);
+}
+
 static void OptVersion(const char *Opt attribute((unused)),
                        const char *Arg attribute((unused)))
 // Print the simulator version
@@ -266,7 +288,8 @@ int main(int argc, char *argv[]) {
        {"--help", 0, OptHelp},       {"--cycles", 0, OptCycles},
        {"--cpu", 1, OptCPU},         {"--trace", 0, OptTrace},
        {"--profile", 1, OptProfile}, {"--verbose", 0, OptVerbose},
-       {"--version", 0, OptVersion},
+       {"--version", 0, OptVersion}, {"--coverage", 1, OptCoverage},
+       {"--dbgfile", 1, OptDbgFile}, {"--heatmap", 1, OptHeatmap},
    };
 
    unsigned I;
@@ -340,6 +363,9 @@ int main(int argc, char *argv[]) {
       AbEnd("No program file");
    }
 
+   // Set up coverage recording, if requested
+   CoverageInit();
+
    // Reset memory
    MemInit();
 
@@ -362,6 +388,9 @@ int main(int argc, char *argv[]) {
    RemainCycles = MaxCycles;
    while (1) {
       Cycles = ExecuteInsn();
+      if (Peripherals.Timer.Control | Peripherals.Timer.Status) {
+         PeripheralsTimerTick();
+      }
       if (MaxCycles) {
          if (Cycles > RemainCycles) {
             ErrorCode(SIM65_ERROR_TIMEOUT, "Maximum number of cycles reached.");
@@ -98,6 +98,71 @@ uint16_t MemReadZPWord(uint8_t Addr)
    return (W | (MemReadByte(Addr) << 8));
 }
 
+static int InAperture(uint16_t Addr)
+// Return true if Addr is part of the peripheral aperture
+{
+   return (PERIPHERALS_APERTURE_BASE_ADDRESS <= Addr) &&
+          (Addr <= PERIPHERALS_APERTURE_LAST_ADDRESS);
+}
+
+static unsigned PlainSize(uint16_t Addr, unsigned Count)
+// Return the number of bytes starting at Addr, but not more than Count, that
+// are plain memory and don't wrap around at the end of the address space.
+{
+   unsigned Limit =
+       (Addr < PERIPHERALS_APERTURE_BASE_ADDRESS) ?
+           PERIPHERALS_APERTURE_BASE_ADDRESS : 0x10000;
+   return (Limit - Addr < Count) ? Limit - Addr : Count;
+}
+
+int MemIsPlain(uint16_t Addr, unsigned Count)
+// Return true if the Count bytes starting at Addr are plain memory that may
+// be accessed directly in Mem: They must neither wrap around at the end of
+// the address space nor overlap with the peripheral aperture.
+{
+   return !InAperture(Addr) && PlainSize(Addr, Count) == Count;
+}
+
+void MemWriteBlock(uint16_t Addr, const uint8_t *Data, unsigned Count)
+// Write Count bytes to memory starting at Addr. The address wraps around at
+// the end of the address space, and writes to the peripheral aperture are
+// passed to the peripherals.
+{
+   while (Count > 0) {
+      unsigned Size;
+      if (InAperture(Addr)) {
+         MemWriteByte(Addr++, *Data++);
+         --Count;
+         continue;
+      }
+      Size = PlainSize(Addr, Count);
+      memcpy(Mem + Addr, Data, Size);
+      Addr += Size;
+      Data += Size;
+      Count -= Size;
+   }
+}
+
+void MemReadBlock(uint16_t Addr, uint8_t *Data, unsigned Count)
+// Read Count bytes from memory starting at Addr. The address wraps around at
+// the end of the address space, and reads from the peripheral aperture are
+// passed to the peripherals.
+{
+   while (Count > 0) {
+      unsigned Size;
+      if (InAperture(Addr)) {
+         *Data++ = MemReadByte(Addr++);
+         --Count;
+         continue;
+      }
+      Size = PlainSize(Addr, Count);
+      memcpy(Data, Mem + Addr, Size);
+      Addr += Size;
+      Data += Size;
+      Count -= Size;
+   }
+}
+
 void MemInit(void)
 // Initialize the memory subsystem
 {
@@ -59,6 +59,21 @@ uint16_t MemReadZPWord(uint8_t Addr);
 // that the read will always be in the zero page, even in case of an address
 // overflow.
 
+int MemIsPlain(uint16_t Addr, unsigned Count);
+// Return true if the Count bytes starting at Addr are plain memory that may
+// be accessed directly in Mem: They must neither wrap around at the end of
+// the address space nor overlap with the peripheral aperture.
+
+void MemWriteBlock(uint16_t Addr, const uint8_t *Data, unsigned Count);
+// Write Count bytes to memory starting at Addr. The address wraps around at
+// the end of the address space, and writes to the peripheral aperture are
+// passed to the peripherals.
+
+void MemReadBlock(uint16_t Addr, uint8_t *Data, unsigned Count);
+// Read Count bytes from memory starting at Addr. The address wraps around at
+// the end of the address space, and reads from the peripheral aperture are
+// passed to the peripherals.
+
 void MemInit(void);
 // Initialize the memory subsystem
 
@@ -46,6 +46,7 @@
 #else
 // Anyone else
 #include <unistd.h>
+#include <dirent.h>
 #endif
 #ifndef S_IREAD
 #define S_IREAD S_IRUSR
@@ -57,13 +58,13 @@
 // common
 #include "cmdline.h"
 #include "print.h"
-#include "xmalloc.h"
 
 // sim65
 #include "6502.h"
 #include "error.h"
 #include "memory.h"
 #include "paravirt.h"
+#include "peripherals.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 //                                   Data
@@ -74,6 +75,32 @@ typedef void (*PVFunc)(CPURegs *Regs);
 static unsigned ArgStart;
 static unsigned char SPAddr;
 
+// Bounce buffer for transfers that can't go directly to or from Mem
+static uint8_t Bounce[0x10000];
+
+#if !defined(_MSC_VER)
+// Open directories. The handle passed to the program is the index plus one.
+static DIR *Dirs[PV_MAX_DIRS];
+#endif
+
+// Offsets and size of the cc65 struct stat
+#define STAT_DEV   0
+#define STAT_INO   4
+#define STAT_MODE  8
+#define STAT_NLINK 9
+#define STAT_UID   13
+#define STAT_GID   14
+#define STAT_SIZE  15
+#define STAT_ATIM  19
+#define STAT_CTIM  27
+#define STAT_MTIM  35
+#define STAT_COUNT 43
+
+// Offsets and size of the sim65 struct dirent
+#define DIRENT_NAME  0
+#define DIRENT_TYPE  64
+#define DIRENT_COUNT 65
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                   Code
 ////////////////////////////////////////////////////////////////////////////////
@@ -97,6 +124,27 @@ static unsigned PopParam(unsigned char Incr) {
    return Val;
 }
 
+static void PutLong(uint8_t *Buf, unsigned long Val) {
+   Buf[0] = Val & 0xFF;
+   Buf[1] = (Val >> 8) & 0xFF;
+   Buf[2] = (Val >> 16) & 0xFF;
+   Buf[3] = (Val >> 24) & 0xFF;
+}
+
+static void ReadPath(char *Path, unsigned Name, const char *Func) {
+   unsigned I = 0;
+
+   do {
+      if (!(Path[I] = MemReadByte((Name + I) & 0xFFFF))) {
+         break;
+      }
+      ++I;
+      if (I >= PV_PATH_SIZE) {
+         Error("%s path too long at address $%04X", Func, Name);
+      }
+   } while (1);
+}
+
 static void PVExit(CPURegs *Regs) {
    Print(stderr, 1, "PVExit ($%02X)\n", Regs->AC);
    SimExit(Regs->AC); // Error code in range 0-255.
@@ -114,12 +162,10 @@ static void PVArgs(CPURegs *Regs) {
 
    SP = Args;
    while (ArgStart < ArgCount) {
-      unsigned I = 0;
       const char *Arg = ArgVec[ArgStart++];
-      SP -= strlen(Arg) + 1;
-      do {
-         MemWriteByte(SP + I, Arg[I]);
-      } while (Arg[I++]);
+      unsigned Len = strlen(Arg) + 1;
+      SP -= Len;
+      MemWriteBlock(SP, (const uint8_t *)Arg, Len);
 
       MemWriteWord(Args, SP);
       Args += 2;
@@ -153,7 +199,7 @@ static void PVOpen(CPURegs *Regs) {
    char Path[PV_PATH_SIZE];
    int OFlag = O_INITIAL;
    int OMode = 0;
-   unsigned RetVal, I = 0;
+   unsigned RetVal;
 
    unsigned Mode = PopParam(Regs->YR - 4);
    unsigned Flags = PopParam(2);
@@ -165,15 +211,7 @@ static void PVOpen(CPURegs *Regs) {
       Mode = 0x01 | 0x02;
    }
 
-   do {
-      if (!(Path[I] = MemReadByte((Name + I) & 0xFFFF))) {
-         break;
-      }
-      ++I;
-      if (I >= PV_PATH_SIZE) {
-         Error("PVOpen path too long at address $%04X", Name);
-      }
-   } while (1);
+   ReadPath(Path, Name, "PVOpen");
 
    Print(stderr, 2, "PVOpen (\"%s\", $%04X)\n", Path, Flags);
 
@@ -235,21 +273,13 @@ static void PVClose(CPURegs *Regs) {
 
 static void PVSysRemove(CPURegs *Regs) {
    char Path[PV_PATH_SIZE];
-   unsigned RetVal, I = 0;
+   unsigned RetVal;
 
    unsigned Name = GetAX(Regs);
 
    Print(stderr, 2, "PVSysRemove ($%04X)\n", Name);
 
-   do {
-      if (!(Path[I] = MemReadByte((Name + I) & 0xFFFF))) {
-         break;
-      }
-      ++I;
-      if (I >= PV_PATH_SIZE) {
-         Error("PVSysRemove path too long at address $%04X", Name);
-      }
-   } while (1);
+   ReadPath(Path, Name, "PVSysRemove");
 
    Print(stderr, 2, "PVSysRemove (\"%s\")\n", Path);
 
@@ -259,8 +289,7 @@ static void PVSysRemove(CPURegs *Regs) {
 }
 
 static void PVRead(CPURegs *Regs) {
-   unsigned char *Data;
-   unsigned RetVal, I = 0;
+   unsigned RetVal;
 
    unsigned Count = GetAX(Regs);
    unsigned Buf = PopParam(2);
@@ -268,23 +297,22 @@ static void PVRead(CPURegs *Regs) {
 
    Print(stderr, 2, "PVRead ($%04X, $%04X, $%04X)\n", FD, Buf, Count);
 
-   Data = xmalloc(Count);
-
-   RetVal = read(FD, Data, Count);
-
-   if (RetVal != (unsigned)-1) {
-      while (I < RetVal) {
-         MemWriteByte(Buf++, Data[I++]);
+   // Read directly into memory if possible, otherwise use the bounce buffer
+   if (MemIsPlain(Buf, Count)) {
+      RetVal = read(FD, Mem + Buf, Count);
+   }
+   else {
+      RetVal = read(FD, Bounce, Count);
+      if (RetVal != (unsigned)-1) {
+         MemWriteBlock(Buf, Bounce, RetVal);
       }
    }
-   xfree(Data);
 
    SetAX(Regs, RetVal);
 }
 
 static void PVWrite(CPURegs *Regs) {
-   unsigned char *Data;
-   unsigned RetVal, I = 0;
+   unsigned RetVal;
 
    unsigned Count = GetAX(Regs);
    unsigned Buf = PopParam(2);
@@ -292,26 +320,189 @@ static void PVWrite(CPURegs *Regs) {
 
    Print(stderr, 2, "PVWrite ($%04X, $%04X, $%04X)\n", FD, Buf, Count);
 
-   Data = xmalloc(Count);
-   while (I < Count) {
-      Data[I++] = MemReadByte(Buf++);
+   // Write directly from memory if possible, otherwise use the bounce buffer
+   if (MemIsPlain(Buf, Count)) {
+      RetVal = write(FD, Mem + Buf, Count);
+   }
+   else {
+      MemReadBlock(Buf, Bounce, Count);
+      RetVal = write(FD, Bounce, Count);
    }
 
-   RetVal = write(FD, Data, Count);
+   SetAX(Regs, RetVal);
+}
 
-   xfree(Data);
+static void PVStat(CPURegs *Regs) {
+   char Path[PV_PATH_SIZE];
+   struct stat S;
+   uint8_t Buf[STAT_COUNT];
 
-   SetAX(Regs, RetVal);
+   unsigned StatBuf = GetAX(Regs);
+   unsigned Name = PopParam(2);
+
+   ReadPath(Path, Name, "PVStat");
+
+   Print(stderr, 2, "PVStat (\"%s\", $%04X)\n", Path, StatBuf);
+
+   if (stat(Path, &S) != 0) {
+      SetAX(Regs, 0xFFFF);
+      return;
+   }
+
+   // Convert to the cc65 struct stat. Nanoseconds are not available on all
+   // hosts and are always zero.
+   memset(Buf, 0, sizeof(Buf));
+   PutLong(Buf + STAT_DEV, S.st_dev);
+   PutLong(Buf + STAT_INO, S.st_ino);
+   if (S.st_mode & S_IREAD) {
+      Buf[STAT_MODE] |= 0x01;
+   }
+   if (S.st_mode & S_IWRITE) {
+      Buf[STAT_MODE] |= 0x02;
+   }
+   PutLong(Buf + STAT_NLINK, S.st_nlink);
+   Buf[STAT_UID] = S.st_uid & 0xFF;
+   Buf[STAT_GID] = S.st_gid & 0xFF;
+   PutLong(Buf + STAT_SIZE, S.st_size);
+   PutLong(Buf + STAT_ATIM, S.st_atime);
+   PutLong(Buf + STAT_CTIM, S.st_ctime);
+   PutLong(Buf + STAT_MTIM, S.st_mtime);
+   MemWriteBlock(StatBuf, Buf, sizeof(Buf));
+
+   SetAX(Regs, 0);
+}
+
+static void PVClockGetTime(CPURegs *Regs) {
+   struct timespec TS;
+   uint8_t Buf[8];
+
+   unsigned TP = GetAX(Regs);
+   unsigned ClockID = PopParam(1) & 0xFF;
+
+   Print(stderr, 2, "PVClockGetTime ($%02X, $%04X)\n", ClockID, TP);
+
+   // Only CLOCK_REALTIME is supported
+   if (ClockID != 0 || !GetWallclockTime(&TS)) {
+      SetAX(Regs, 0xFFFF);
+      return;
+   }
+
+   PutLong(Buf, (unsigned long)TS.tv_sec);
+   PutLong(Buf + 4, (unsigned long)TS.tv_nsec);
+   MemWriteBlock(TP, Buf, sizeof(Buf));
+
+   SetAX(Regs, 0);
+}
+
+#if defined(_MSC_VER)
+
+// Directories are not supported for the Microsoft compiler
+
+static void PVOpenDir(CPURegs *Regs) {
+   SetAX(Regs, 0);
+}
+
+static void PVReadDir(CPURegs *Regs) {
+   PopParam(2);
+   SetAX(Regs, 0);
 }
 
+static void PVCloseDir(CPURegs *Regs) {
+   SetAX(Regs, 0xFFFF);
+}
+
+#else
+
+static void PVOpenDir(CPURegs *Regs) {
+   char Path[PV_PATH_SIZE];
+   unsigned I;
+
+   unsigned Name = GetAX(Regs);
+
+   ReadPath(Path, Name, "PVOpenDir");
+
+   Print(stderr, 2, "PVOpenDir (\"%s\")\n", Path);
+
+   // Find a free slot
+   for (I = 0; I < PV_MAX_DIRS; ++I) {
+      if (Dirs[I] == 0) {
+         break;
+      }
+   }
+   if (I == PV_MAX_DIRS || (Dirs[I] = opendir(Path)) == 0) {
+      SetAX(Regs, 0);
+      return;
+   }
+
+   SetAX(Regs, I + 1);
+}
+
+static void PVReadDir(CPURegs *Regs) {
+   struct dirent *E;
+   uint8_t Buf[DIRENT_COUNT];
+   size_t Len;
+
+   unsigned Entry = GetAX(Regs);
+   unsigned Dir = PopParam(2);
+
+   Print(stderr, 2, "PVReadDir ($%04X, $%04X)\n", Dir, Entry);
+
+   if (Dir == 0 || Dir > PV_MAX_DIRS || Dirs[Dir - 1] == 0 ||
+       (E = readdir(Dirs[Dir - 1])) == 0) {
+      SetAX(Regs, 0);
+      return;
+   }
+
+   // Convert to the sim65 struct dirent, truncating long names
+   memset(Buf, 0, sizeof(Buf));
+   Len = strlen(E->d_name);
+   if (Len > DIRENT_TYPE - 1) {
+      Len = DIRENT_TYPE - 1;
+   }
+   memcpy(Buf + DIRENT_NAME, E->d_name, Len);
+#if defined(DT_REG) && defined(DT_DIR) && defined(DT_LNK)
+   switch (E->d_type) {
+      case DT_REG:
+         Buf[DIRENT_TYPE] = 1;
+         break;
+      case DT_DIR:
+         Buf[DIRENT_TYPE] = 2;
+         break;
+      case DT_LNK:
+         Buf[DIRENT_TYPE] = 3;
+         break;
+   }
+#endif
+   MemWriteBlock(Entry, Buf, sizeof(Buf));
+
+   SetAX(Regs, Entry);
+}
+
+static void PVCloseDir(CPURegs *Regs) {
+   unsigned Dir = GetAX(Regs);
+
+   Print(stderr, 2, "PVCloseDir ($%04X)\n", Dir);
+
+   if (Dir == 0 || Dir > PV_MAX_DIRS || Dirs[Dir - 1] == 0) {
+      SetAX(Regs, 0xFFFF);
+      return;
+   }
+
+   SetAX(Regs, closedir(Dirs[Dir - 1]) == 0 ? 0 : 0xFFFF);
+   Dirs[Dir - 1] = 0;
+}
+
+#endif
+
 static void PVOSMapErrno(CPURegs *Regs) {
    unsigned err = GetAX(Regs);
    SetAX(Regs, err != 0 ? -1 : 0);
 }
 
 static const PVFunc Hooks[] = {
-    PVLseek, PVSysRemove, PVOSMapErrno, PVOpen, PVClose,
-    PVRead,  PVWrite,     PVArgs,       PVExit,
+    PVClockGetTime, PVStat,      PVOpenDir,    PVReadDir, PVCloseDir,
+    PVLseek,        PVSysRemove, PVOSMapErrno, PVOpen,    PVClose,
+    PVRead,         PVWrite,     PVArgs,       PVExit,
 };
 
 void ParaVirtInit(unsigned aArgStart, unsigned char aSPAddr)
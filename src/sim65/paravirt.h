@@ -40,11 +40,14 @@
 //                                   Data
 ////////////////////////////////////////////////////////////////////////////////
 
-#define PARAVIRT_BASE 0xFFF1
+#define PARAVIRT_BASE 0xFFEC
 // Lowest address used by a paravirtualization hook
 
 #define PV_PATH_SIZE 1024
-// Maximum path size supported by PVOpen/PVSysRemove
+// Maximum path size supported by PVOpen/PVSysRemove/PVStat/PVOpenDir
+
+#define PV_MAX_DIRS 8
+// Maximum number of directories that may be open at the same time
 
 ////////////////////////////////////////////////////////////////////////////////
 //                                   Code
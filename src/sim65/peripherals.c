@@ -50,7 +50,7 @@ Sim65Peripherals Peripherals;
 //                                   Code
 ////////////////////////////////////////////////////////////////////////////////
 
-static bool GetWallclockTime(struct timespec *ts)
+bool GetWallclockTime(struct timespec *ts)
 // Get the wallclock time with nanosecond resolution.
 {
    // Note: the 'struct timespec' type is available on all compilers we want to
@@ -159,6 +159,37 @@ void PeripheralsWriteByte(uint8_t Addr, uint8_t Val)
          break;
       }
 
+         // Handle writes to the Timer peripheral.
+
+      case PERIPHERALS_TIMER_ADDRESS_OFFSET_CONTROL: {
+         // Setting the enable bit (re)starts the timer. The period counts
+         // from the start of the instruction that does the write.
+         Peripherals.Timer.Control = Val;
+         if (Val & PERIPHERALS_TIMER_CONTROL_ENABLE) {
+            Peripherals.Timer.Deadline =
+                Peripherals.Counter.ClockCycles + Peripherals.Timer.Period;
+         }
+         break;
+      }
+
+      case PERIPHERALS_TIMER_ADDRESS_OFFSET_STATUS: {
+         // Any write acknowledges the timer and releases the IRQ line.
+         Peripherals.Timer.Status = 0;
+         IRQClear();
+         break;
+      }
+
+      case PERIPHERALS_TIMER_ADDRESS_OFFSET_PERIOD + 0:
+      case PERIPHERALS_TIMER_ADDRESS_OFFSET_PERIOD + 1:
+      case PERIPHERALS_TIMER_ADDRESS_OFFSET_PERIOD + 2:
+      case PERIPHERALS_TIMER_ADDRESS_OFFSET_PERIOD + 3: {
+         unsigned Shift = (Addr - PERIPHERALS_TIMER_ADDRESS_OFFSET_PERIOD) * 8;
+         Peripherals.Timer.Period =
+             (Peripherals.Timer.Period & ~((uint32_t)0xFF << Shift)) |
+             ((uint32_t)Val << Shift);
+         break;
+      }
+
          // Handle writes to unused and read-only peripheral addresses.
 
       default: {
@@ -228,6 +259,24 @@ uint8_t PeripheralsReadByte(uint8_t Addr)
          return TraceMode;
       }
 
+         // Handle reads from the Timer peripheral.
+
+      case PERIPHERALS_TIMER_ADDRESS_OFFSET_CONTROL: {
+         return Peripherals.Timer.Control;
+      }
+
+      case PERIPHERALS_TIMER_ADDRESS_OFFSET_STATUS: {
+         return Peripherals.Timer.Status;
+      }
+
+      case PERIPHERALS_TIMER_ADDRESS_OFFSET_PERIOD + 0:
+      case PERIPHERALS_TIMER_ADDRESS_OFFSET_PERIOD + 1:
+      case PERIPHERALS_TIMER_ADDRESS_OFFSET_PERIOD + 2:
+      case PERIPHERALS_TIMER_ADDRESS_OFFSET_PERIOD + 3: {
+         unsigned Shift = (Addr - PERIPHERALS_TIMER_ADDRESS_OFFSET_PERIOD) * 8;
+         return (uint8_t)(Peripherals.Timer.Period >> Shift);
+      }
+
          // Handle reads from unused peripheral and write-only addresses.
 
       default: {
@@ -255,4 +304,43 @@ void PeripheralsInit(void)
    Peripherals.Counter.LatchedWallclockTimeSplit = 0;
 
    Peripherals.Counter.LatchedValueSelected = 0;
+
+   // Initialize the Timer peripheral
+
+   Peripherals.Timer.Control = 0;
+   Peripherals.Timer.Status = 0;
+   Peripherals.Timer.Period = 0;
+   Peripherals.Timer.Deadline = 0;
+}
+
+void PeripheralsTimerTick(void)
+// Check the timer after an instruction and request interrupts if needed.
+{
+   TimerPeripheral *T = &Peripherals.Timer;
+
+   if ((T->Control & PERIPHERALS_TIMER_CONTROL_ENABLE) &&
+       Peripherals.Counter.ClockCycles >= T->Deadline) {
+
+      T->Status |= PERIPHERALS_TIMER_STATUS_EXPIRED;
+
+      if (T->Control & PERIPHERALS_TIMER_CONTROL_ONESHOT) {
+         T->Control &= ~PERIPHERALS_TIMER_CONTROL_ENABLE;
+      }
+      else {
+         // Count from the deadline, not from now, so the period doesn't
+         // drift with the length of the instructions.
+         T->Deadline += T->Period ? T->Period : 1;
+      }
+
+      // NMI is edge triggered, one request per expiry.
+      if (T->Control & PERIPHERALS_TIMER_CONTROL_NMI) {
+         NMIRequest();
+      }
+   }
+
+   // IRQ is level triggered, and stays active until acknowledged.
+   if ((T->Status & PERIPHERALS_TIMER_STATUS_EXPIRED) &&
+       !(T->Control & PERIPHERALS_TIMER_CONTROL_NMI)) {
+      IRQRequest();
+   }
 }
@@ -31,12 +31,14 @@
 #ifndef PERIPHERALS_H
 #define PERIPHERALS_H
 
+#include <stdbool.h>
 #include <stdint.h>
+#include <time.h>
 
 // The memory range where the memory-mapped peripherals can be accessed.
 
 #define PERIPHERALS_APERTURE_BASE_ADDRESS 0xffc0
-#define PERIPHERALS_APERTURE_LAST_ADDRESS 0xffcb
+#define PERIPHERALS_APERTURE_LAST_ADDRESS 0xffd1
 
 // Declarations for the COUNTER peripheral
 
@@ -97,11 +99,47 @@ typedef struct {
    (PERIPHERALS_APERTURE_BASE_ADDRESS +                                        \
     PERIPHERALS_SIMCONTROL_ADDRESS_OFFSET_TRACEMODE)
 
+// Declarations for the TIMER peripheral.
+
+#define PERIPHERALS_TIMER_ADDRESS_OFFSET_CONTROL 0x0C
+#define PERIPHERALS_TIMER_ADDRESS_OFFSET_STATUS 0x0D
+#define PERIPHERALS_TIMER_ADDRESS_OFFSET_PERIOD 0x0E
+
+#define PERIPHERALS_TIMER_CONTROL                                              \
+   (PERIPHERALS_APERTURE_BASE_ADDRESS +                                        \
+    PERIPHERALS_TIMER_ADDRESS_OFFSET_CONTROL)
+#define PERIPHERALS_TIMER_STATUS                                               \
+   (PERIPHERALS_APERTURE_BASE_ADDRESS +                                        \
+    PERIPHERALS_TIMER_ADDRESS_OFFSET_STATUS)
+#define PERIPHERALS_TIMER_PERIOD                                               \
+   (PERIPHERALS_APERTURE_BASE_ADDRESS +                                        \
+    PERIPHERALS_TIMER_ADDRESS_OFFSET_PERIOD)
+
+#define PERIPHERALS_TIMER_CONTROL_ENABLE 0x01
+#define PERIPHERALS_TIMER_CONTROL_ONESHOT 0x02
+#define PERIPHERALS_TIMER_CONTROL_NMI 0x04
+
+#define PERIPHERALS_TIMER_STATUS_EXPIRED 0x01
+
+typedef struct {
+   // Control register: enable, one-shot and NMI bits.
+   uint8_t Control;
+   // Status register. The expired bit is set when the timer expires, and is
+   // cleared by writing any value to the status register. In IRQ mode, the
+   // IRQ line stays active while the bit is set.
+   uint8_t Status;
+   // The period in clock cycles, written and read one byte at a time.
+   uint32_t Period;
+   // The value of the clock cycle counter when the timer expires next.
+   uint64_t Deadline;
+} TimerPeripheral;
+
 // Declare the 'Sim65Peripherals' type and its single instance 'Peripherals'.
 
 typedef struct {
    // State of the peripherals available in sim65.
    CounterPeripheral Counter;
+   TimerPeripheral Timer;
 } Sim65Peripherals;
 
 extern Sim65Peripherals Peripherals;
@@ -110,6 +148,9 @@ extern Sim65Peripherals Peripherals;
 //                                   Code
 ////////////////////////////////////////////////////////////////////////////////
 
+bool GetWallclockTime(struct timespec *ts);
+// Get the wallclock time with nanosecond resolution.
+
 void PeripheralsWriteByte(uint8_t Addr, uint8_t Val);
 // Write a byte to a memory location in the peripheral address aperture.
 
@@ -119,6 +160,9 @@ uint8_t PeripheralsReadByte(uint8_t Addr);
 void PeripheralsInit(void);
 // Initialize the peripherals.
 
+void PeripheralsTimerTick(void);
+// Check the timer after an instruction and request interrupts if needed.
+
 // End of peripherals.h
 
 #endif
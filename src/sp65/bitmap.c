@@ -153,3 +153,21 @@ Pixel GetPixel(const Bitmap *B, unsigned X, unsigned Y)
    // Return the pixel
    return B->Data[Y * B->Width + X];
 }
+
+void GetIndexRow(const Bitmap *B, unsigned Y, unsigned char *Row)
+// Copy the palette indices of line Y of an indexed bitmap into Row, which
+// must have room for the width of the bitmap. Converters use this instead of
+// GetPixel, so their inner loops work on a contiguous byte array.
+{
+   const Pixel *P;
+   unsigned X;
+
+   // Check the coordinates
+   PRECONDITION(Y < B->Height);
+
+   // Copy the line. This loop is simple enough to be vectorized.
+   P = B->Data + Y * B->Width;
+   for (X = 0; X < B->Width; ++X) {
+      Row[X] = (unsigned char)P[X].Index;
+   }
+}
@@ -103,6 +103,11 @@ Pixel GetPixel(const Bitmap *B, unsigned X, unsigned Y);
 // Return a pixel from the bitmap. The returned value may either be a color
 // or a palette index, depending on the type of the bitmap.
 
+void GetIndexRow(const Bitmap *B, unsigned Y, unsigned char *Row);
+// Copy the palette indices of line Y of an indexed bitmap into Row, which
+// must have room for the width of the bitmap. Converters use this instead of
+// GetPixel, so their inner loops work on a contiguous byte array.
+
 #if defined(HAVE_INLINE)
 INLINE int BitmapIsIndexed(const Bitmap *B)
 // Return true if this is an indexed bitmap
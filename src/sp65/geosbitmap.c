@@ -130,6 +130,7 @@ StrBuf *GenGeosBitmap(const Bitmap *B, const Collection *A attribute((unused)))
    unsigned LineWidth;
    unsigned char *Buf;
    unsigned char *BP;
+   unsigned char Row[BM_MAX_WIDTH];
    StrBuf *D;
    unsigned X, Y;
    struct RLE RLE;
@@ -154,6 +155,7 @@ StrBuf *GenGeosBitmap(const Bitmap *B, const Collection *A attribute((unused)))
    // Convert the bitmap into a raw image
    BP = Buf;
    for (Y = 0; Y < GetBitmapHeight(B); ++Y) {
+      GetIndexRow(B, Y, Row);
       for (X = 0; X < GetBitmapWidth(B);) {
          unsigned char V = 0;
          int Bits = 8;
@@ -161,7 +163,7 @@ StrBuf *GenGeosBitmap(const Bitmap *B, const Collection *A attribute((unused)))
             Bits = (GetBitmapWidth(B) - X);
          }
          while (--Bits >= 0) {
-            V |= (GetPixel(B, X++, Y).Index & 0x01) << Bits;
+            V |= (Row[X++] & 0x01) << Bits;
          }
          *BP++ = V;
       }
@@ -58,6 +58,7 @@ StrBuf *GenGeosIcon(const Bitmap *B, const Collection *A attribute((unused)))
 // returned.
 {
    StrBuf *D;
+   unsigned char Row[WIDTH];
    unsigned X, Y;
 
    // Output the image properties
@@ -78,10 +79,11 @@ StrBuf *GenGeosIcon(const Bitmap *B, const Collection *A attribute((unused)))
    // Convert the image
    for (Y = 0; Y < HEIGHT; ++Y) {
       unsigned char V = 0;
+      GetIndexRow(B, Y, Row);
       for (X = 0; X < WIDTH; ++X) {
 
          // Fetch next bit into byte buffer
-         V = (V << 1) | (GetPixel(B, X, Y).Index & 0x01);
+         V = (V << 1) | (Row[X] & 0x01);
 
          // Store full bytes into the output buffer
          if ((X & 0x07) == 0x07) {
@@ -57,6 +57,7 @@ StrBuf *GenKoala(const Bitmap *B, const Collection *A attribute((unused)))
 {
    StrBuf *D;
    unsigned char Screen[160][200];
+   unsigned char Row[WIDTH];
    unsigned char X, Y;
 
    // Koala pictures are always 160x200 in size with 16 colors
@@ -70,8 +71,9 @@ StrBuf *GenKoala(const Bitmap *B, const Collection *A attribute((unused)))
 
    // Read the image into Screen
    for (Y = 0; Y < HEIGHT; ++Y) {
+      GetIndexRow(B, Y, Row);
       for (X = 0; X < WIDTH; ++X) {
-         Screen[X][Y] = (unsigned char)GetPixel(B, X, Y).Index;
+         Screen[X][Y] = Row[X];
       }
    }
 
@@ -144,12 +144,14 @@ static void OptimizePenpal(const Bitmap *B, char *PenPal)
 // Create an optimal Penpal
 {
    char usage[16];
+   unsigned char Row[BM_MAX_WIDTH];
    unsigned I, J, Val;
 
    memset(usage, 0, sizeof(usage));
    for (J = 0; J < GetBitmapHeight(B); J++) {
+      GetIndexRow(B, J, Row);
       for (I = 0; I < GetBitmapWidth(B); I++) {
-         Val = GetPixel(B, I, J).Index;
+         Val = Row[I];
          if (Val < 16) {
             usage[Val] = 1;
          }
@@ -506,6 +508,7 @@ StrBuf *GenLynxSprite(const Bitmap *B, const Collection *A)
    signed PenColors;
    char PenPal[18];
    signed Val;
+   unsigned char Row[BM_MAX_WIDTH];
 
    // Get EdgeIndex
    EdgeIndex = GetEdgeIndex(A);
@@ -650,9 +653,10 @@ StrBuf *GenLynxSprite(const Bitmap *B, const Collection *A)
                char LineBuffer[512]; // The maximum size is 508 pixels
 
                // Fill the LineBuffer for easier optimisation
+               GetIndexRow(B, Y, Row);
                for (X = OX; X < (signed)GetBitmapWidth(B); ++X) {
                   // Fetch next bit into byte buffer
-                  Val = GetPixel(B, X, Y).Index;
+                  Val = Row[X];
                   if (Val > 16)
                      Val = 16;
                   LineBuffer[i] = Map[Val] & ColorMask;
@@ -693,9 +697,10 @@ StrBuf *GenLynxSprite(const Bitmap *B, const Collection *A)
                char LineBuffer[512]; // The maximum size is 508 pixels
 
                // Fill the LineBuffer for easier optimisation
+               GetIndexRow(B, Y, Row);
                for (X = OX; X < (signed)GetBitmapWidth(B); ++X) {
                   // Fetch next bit into byte buffer
-                  Val = GetPixel(B, X, Y).Index;
+                  Val = Row[X];
                   if (Val > 16)
                      Val = 16;
 
@@ -738,9 +743,10 @@ StrBuf *GenLynxSprite(const Bitmap *B, const Collection *A)
                char LineBuffer[512]; // The maximum size is 508 pixels
 
                // Fill the LineBuffer for easier optimisation
+               GetIndexRow(B, Y, Row);
                for (X = OX - 1; X >= 0; --X) {
                   // Fetch next bit into byte buffer
-                  Val = GetPixel(B, X, Y).Index;
+                  Val = Row[X];
                   if (Val > 16)
                      Val = 16;
 
@@ -783,9 +789,10 @@ StrBuf *GenLynxSprite(const Bitmap *B, const Collection *A)
                char LineBuffer[512]; // The maximum size is 508 pixels
 
                // Fill the LineBuffer for easier optimisation
+               GetIndexRow(B, Y, Row);
                for (X = OX - 1; X >= 0; --X) {
                   // Fetch next bit into byte buffer
-                  Val = GetPixel(B, X, Y).Index;
+                  Val = Row[X];
                   if (Val > 16)
                      Val = 16;
 
@@ -37,10 +37,11 @@
 #include <errno.h>
 
 // common
-#include "abend.h"
 #include "cmdline.h"
+#include "fname.h"
 #include "print.h"
 #include "version.h"
+#include "xmalloc.h"
 
 // sp65
 #include "attr.h"
@@ -66,6 +67,10 @@ static StrBuf *D;
 // Output data from palconv
 static StrBuf *E;
 
+// Conversion and output for file names given without an option
+static char *BatchConvert;
+static char *BatchWrite;
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                                             Code
 ////////////////////////////////////////////////////////////////////////////////
@@ -85,6 +90,8 @@ static void Usage(void)
           "  -w file[,attrlist]\t\tWrite the output to a file\n"
           "\n"
           "Long options:\n"
+          "  --batch-convert fmt[,attrlist]\tConvert all following files\n"
+          "  --batch-write ext[,attrlist]\tWrite all following files\n"
           "  --convert-to fmt[,attrlist]\tConvert into target format\n"
           "  --help\t\t\tHelp (this text)\n"
           "  --list-conversions\t\tList all possible conversions\n"
@@ -137,6 +144,21 @@ static void SetPalOutputData(StrBuf *N)
    E = N;
 }
 
+static void OptBatchConvert(const char *Opt attribute((unused)),
+                            const char *Arg)
+// Set the conversion for the following input files
+{
+   xfree(BatchConvert);
+   BatchConvert = xstrdup(Arg);
+}
+
+static void OptBatchWrite(const char *Opt attribute((unused)), const char *Arg)
+// Set the output for the following input files
+{
+   xfree(BatchWrite);
+   BatchWrite = xstrdup(Arg);
+}
+
 static void OptConvertTo(const char *Opt attribute((unused)), const char *Arg)
 // Convert the bitmap into a target format
 {
@@ -313,11 +335,47 @@ static void OptWrite(const char *Opt attribute((unused)), const char *Arg)
    FreeAttrList(A);
 }
 
+static void ConvertFile(const char *Name)
+// Read, convert and write a file given without an option, using the settings
+// from --batch-convert and --batch-write. The name of the output file is the
+// name of the input file with the extension replaced.
+{
+   static const char *const NameList[] = {"ext", "format"};
+   Collection *A;
+   char *Output;
+
+   // We must know what to do with the file
+   if (BatchConvert == 0 || BatchWrite == 0) {
+      Error("Don't know what to do with '%s'", Name);
+   }
+
+   // Read the file and use it as original and as working copy
+   A = NewCollection();
+   AddAttr(A, "name", Name);
+   SetWorkBitmap(0);
+   FreeBitmap(B);
+   B = C = ReadInputFile(A);
+   FreeAttrList(A);
+
+   // Convert the bitmap
+   OptConvertTo(0, BatchConvert);
+
+   // Write the output file
+   A = ParseAttrList(BatchWrite, NameList, 2);
+   Output = MakeFilename(Name, NeedAttrVal(A, "ext", "batch-write"));
+   AddAttr(A, "name", Output);
+   WriteOutputFile(D, A, C);
+   FreeAttrList(A);
+   xfree(Output);
+}
+
 int main(int argc, char *argv[])
 // sp65 main program
 {
    // Program long options
    static const LongOpt OptTab[] = {
+       {"--batch-convert", 1, OptBatchConvert},
+       {"--batch-write", 1, OptBatchWrite},
        {"--convert-to", 1, OptConvertTo},
        {"--dump-palette", 0, OptDumpPalette},
        {"--help", 0, OptHelp},
@@ -393,8 +451,8 @@ int main(int argc, char *argv[])
          }
       }
       else {
-         // We don't accept anything else
-         AbEnd("Don't know what to do with '%s'", Arg);
+         // Anything else is an input file for batch conversion
+         ConvertFile(Arg);
       }
 
       // Next argument
@@ -410,6 +468,8 @@ int main(int argc, char *argv[])
    SetWorkBitmap(C);
    FreeBitmap(B);
    FreeStrBuf(D);
+   xfree(BatchConvert);
+   xfree(BatchWrite);
 
    // Success
    return EXIT_SUCCESS;
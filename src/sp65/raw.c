@@ -49,7 +49,8 @@ StrBuf *GenRaw(const Bitmap *B, const Collection *A attribute((unused)))
 // buffer (which is actually a dynamic char array) and returned.
 {
    StrBuf *D;
-   unsigned X, Y;
+   unsigned char Row[BM_MAX_WIDTH];
+   unsigned Y;
 
    // Output the image properties
    Print(stdout, 1, "Image is %ux%u with %u colors%s\n", GetBitmapWidth(B),
@@ -67,10 +68,9 @@ StrBuf *GenRaw(const Bitmap *B, const Collection *A attribute((unused)))
 
    // Convert the image
    for (Y = 0; Y < GetBitmapHeight(B); ++Y) {
-      for (X = 0; X < GetBitmapWidth(B); ++X) {
-         // Place one pixel into the buffer
-         SB_AppendChar(D, (unsigned char)GetPixel(B, X, Y).Index);
-      }
+      // Place one line of pixels into the buffer
+      GetIndexRow(B, Y, Row);
+      SB_AppendBuf(D, (const char *)Row, GetBitmapWidth(B));
    }
 
    // Return the converted bitmap
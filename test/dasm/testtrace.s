@@ -0,0 +1,24 @@
+; Code mixed with data, disassembled with --trace. The code is found by
+; following the code flow from the CPU vectors.
+
+        .setcpu "6502"
+        .org    $F000
+
+reset:  ldx     #$00
+loop:   lda     msg,x
+        beq     done
+        jsr     out
+        inx
+        bne     loop
+done:   jmp     done
+
+; Data that looks like code
+msg:    .byte   "HELLO", $00, $A9, $4C, $20
+
+out:    sta     $D000
+        rts
+
+nmi:    rti
+
+        .res    $FFFA - *, $FF
+        .addr   nmi, reset, nmi
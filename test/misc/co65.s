@@ -0,0 +1,42 @@
+;
+; co65: A module with all segments, or with code only if SMALL is defined.
+; Both are converted in one co65 run.
+;
+
+        .export         _first, _second
+
+        .segment        "HEADER"
+
+        .byte   $61
+        .addr   _first
+
+.ifndef SMALL
+        .zeropage
+
+ptr:    .res    2
+.endif
+
+        .code
+
+_first: jsr     _second
+.ifndef SMALL
+        lda     table,x
+        sta     ptr
+.endif
+        jmp     _second
+_second:
+        rts
+
+.ifndef SMALL
+        .rodata
+
+table:  .word   _first, _second, table
+
+        .data
+
+vector: .addr   _first
+
+        .bss
+
+buffer: .res    16
+.endif
@@ -0,0 +1,102 @@
+/*
+** Tests for the size class allocator (libsrc/common/extra/heapclass.s),
+** which is linked in place of the default malloc() and free().
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SLOTS   64
+
+static unsigned char* Block[SLOTS];
+static unsigned Size[SLOTS];
+static unsigned long Seed = 1;
+static unsigned Failures = 0;
+
+static unsigned Random (void)
+{
+    Seed = Seed * 1103515245UL + 12345UL;
+    return (unsigned) (Seed >> 16);
+}
+
+static void Check (int Cond, const char* Msg, unsigned Val)
+{
+    if (!Cond) {
+        printf ("%s (%u)\n", Msg, Val);
+        ++Failures;
+    }
+}
+
+static void Fill (unsigned I)
+{
+    memset (Block[I], (unsigned char) I, Size[I]);
+}
+
+static void Verify (unsigned I)
+{
+    unsigned J;
+    for (J = 0; J < Size[I]; ++J) {
+        if (Block[I][J] != (unsigned char) I) {
+            Check (0, "block contents destroyed", I);
+            return;
+        }
+    }
+}
+
+int main (void)
+{
+    unsigned I, N;
+    unsigned char* P;
+    size_t Avail = _heapmemavail ();
+
+    /* Same size blocks are reused */
+    P = malloc (10);
+    free (P);
+    Check (malloc (10) == P, "small block not reused", 10);
+    Check (_heapblocksize (P) >= 10, "bad block size", _heapblocksize (P));
+    free (P);
+
+    /* Churn with mostly small and some large blocks */
+    for (N = 0; N < 4000; ++N) {
+        I = Random () % SLOTS;
+        if (Block[I]) {
+            Verify (I);
+            if (Random () & 1) {
+                free (Block[I]);
+                Block[I] = 0;
+                continue;
+            }
+            Size[I] = Random () % 120 + 1;
+            Block[I] = realloc (Block[I], Size[I]);
+        } else {
+            Size[I] = (Random () & 7) ? Random () % 92 + 1 : Random () % 600 + 1;
+            Block[I] = malloc (Size[I]);
+        }
+        Check (Block[I] != 0, "out of memory", Size[I]);
+        Fill (I);
+    }
+    for (I = 0; I < SLOTS; ++I) {
+        if (Block[I]) {
+            Verify (I);
+            free (Block[I]);
+        }
+    }
+
+    /* All memory must be available again */
+    Check (_heapmemavail () == Avail, "memory lost", _heapmemavail ());
+
+    /* Blocks held in the class lists are used when the heap is exhausted */
+    for (I = 0; I < SLOTS; ++I) {
+        Block[I] = malloc (8);
+    }
+    for (I = 0; I < SLOTS; ++I) {
+        free (Block[I]);
+    }
+    P = malloc (_heapmaxavail ());
+    Check (P != 0, "cannot allocate the largest block", 0);
+    free (P);
+    Check (_heapmemavail () == Avail, "memory lost", _heapmemavail ());
+
+    return Failures != 0;
+}
@@ -0,0 +1,6 @@
+/* cl65 --jobs: A file that doesn't compile */
+
+int Error (void)
+{
+    return undefined;
+}
@@ -0,0 +1,8 @@
+/* cl65 --jobs: The main file of a program compiled in parallel */
+
+extern int Sub (int X);
+
+int main (void)
+{
+    return Sub (2) != 4;
+}
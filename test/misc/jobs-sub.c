@@ -0,0 +1,10 @@
+/* cl65 --jobs: A second file of a program compiled in parallel, that gives
+** a warning
+*/
+
+int Sub (int X)
+{
+    int Unused;
+
+    return X * 2;
+}
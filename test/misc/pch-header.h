@@ -0,0 +1,20 @@
+/* cc65 --create-pch: A header that is precompiled */
+
+#include <stdlib.h>
+#include <string.h>
+
+#define PCH_TEXT        "precompiled"
+
+#ifdef PCH_EXTRA
+#define PCH_LENGTH      12
+#else
+#define PCH_LENGTH      11
+#endif
+
+unsigned PchLength (const char* S);
+
+/* PCH_FUNC is defined on the command line. The header removes it, so the
+** function below has this name, and not the one from the command line.
+*/
+#undef PCH_FUNC
+unsigned PCH_FUNC (void);
@@ -0,0 +1,18 @@
+/* cc65 --use-pch: A program that is compiled with a precompiled header */
+
+#include "pch-header.h"
+
+unsigned PchLength (const char* S)
+{
+    return strlen (S);
+}
+
+int main (void)
+{
+    return PchLength (PCH_TEXT) == PCH_FUNC () ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+unsigned PCH_FUNC (void)
+{
+    return PCH_LENGTH;
+}
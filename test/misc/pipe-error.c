@@ -0,0 +1,11 @@
+/* cl65 --pipe: A file that doesn't compile */
+
+static int Ok (void)
+{
+    return 0;
+}
+
+int main (void)
+{
+    return Ok () + undefined;
+}
@@ -0,0 +1,10 @@
+/* cl65 --pipe: A program that is compiled and assembled through a pipe */
+
+#include <string.h>
+
+static const char Text[] = "pipe";
+
+int main (void)
+{
+    return strlen (Text) != 4;
+}
@@ -0,0 +1,38 @@
+/* cc65 --profile-use: pragmas in cold statements stay in effect after them */
+
+#include <string.h>
+
+static char Buf[16];
+static unsigned Count;
+
+static void Add (unsigned A, unsigned B, unsigned C)
+{
+    Count += A + B + C;
+}
+
+unsigned Set (unsigned char X)
+{
+    if (X)
+    {
+#pragma inline-stdfuncs (on)
+        ++Count;
+    }
+    return strlen (Buf);
+}
+
+unsigned PushPop (unsigned char X)
+{
+    if (X)
+    {
+#pragma codesize (push, 200)
+        ++Count;
+    }
+    Add (X, X, strlen (Buf));
+#pragma codesize (pop)
+    return Count;
+}
+
+int main (void)
+{
+    return Set (0) + PushPop (0);
+}
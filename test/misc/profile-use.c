@@ -0,0 +1,20 @@
+/* cc65 --profile-use: hot statements are compiled for speed, cold ones for size */
+
+#include <string.h>
+
+static char Buf[16];
+
+unsigned Hot (void)
+{
+    return strlen (Buf);
+}
+
+unsigned Cold (void)
+{
+    return strlen (Buf);
+}
+
+int main (void)
+{
+    return Hot () + Cold ();
+}
@@ -0,0 +1,47 @@
+;
+; sim65 --coverage: Lines and branches executed by a small program. It is
+; linked without the library, so the report contains only this file.
+;
+
+        .export         __EXEHDR__ : absolute = 1
+        .exportzp       c_sp
+        .import         __MAIN_START__
+
+        .zeropage
+
+c_sp:   .res    2
+count:  .res    1
+
+        .segment        "EXEHDR"
+
+        .byte   $73, $69, $6D, $36, $35         ; 'sim65'
+        .byte   2                               ; header version
+        .byte   0                               ; 6502
+        .byte   c_sp                            ; c_sp address
+        .addr   __MAIN_START__                  ; load address
+        .addr   start                           ; reset address
+
+        .segment        "STARTUP"
+
+; Count the odd numbers below 4. The branch in the loop goes both ways, the
+; final check always branches, and never is never executed.
+
+start:  lda     #0
+        sta     count
+        ldx     #0
+loop:   txa
+        and     #1
+        beq     even
+        inc     count
+even:   inx
+        cpx     #4
+        bne     loop
+        lda     count
+        cmp     #2
+        beq     done
+        jsr     never
+done:   lda     #0
+        jmp     $FFF9                           ; exit
+
+never:  lda     #1
+        rts
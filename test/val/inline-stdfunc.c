@@ -0,0 +1,155 @@
+/*
+** Test the inlined versions of the standard string and memory functions.
+** The test is compiled with all optimization options, so it covers both the
+** inlined code and the library calls.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static unsigned char failures;
+
+static unsigned char src[200];
+static unsigned char dst[200];
+static char str[40];
+static unsigned char gsize;
+
+static void check(int cond, const char *what)
+{
+    if (!cond) {
+        printf("failed: %s\n", what);
+        ++failures;
+    }
+}
+
+static void fill(void)
+{
+    unsigned char i;
+
+    for (i = 0; i < sizeof(src); ++i) {
+        src[i] = i + 1;
+    }
+    memset(dst, 0xEE, sizeof(dst));
+}
+
+static int sign(int x)
+{
+    return x < 0 ? -1 : (x > 0 ? 1 : 0);
+}
+
+static void test_memcpy(void)
+{
+    unsigned char lsize;
+    register unsigned char *rdst = dst;
+
+    /* Size in a global variable */
+    fill();
+    gsize = 150;
+    memcpy(dst, src, gsize);
+    check(dst[0] == 1 && dst[149] == 150 && dst[150] == 0xEE, "memcpy global size");
+
+    /* Size zero */
+    fill();
+    gsize = 0;
+    memcpy(dst, src, gsize);
+    check(dst[0] == 0xEE, "memcpy zero size");
+
+    /* Size in a local variable */
+    fill();
+    lsize = 199;
+    memcpy(dst, src, lsize);
+    check(dst[0] == 1 && dst[198] == 199 && dst[199] == 0xEE, "memcpy local size");
+
+    /* Destination in a register variable */
+    fill();
+    gsize = 1;
+    memcpy(rdst, src, gsize);
+    check(dst[0] == 1 && dst[1] == 0xEE, "memcpy register destination");
+}
+
+static void test_memset(void)
+{
+    unsigned char lsize;
+    register unsigned char *rdst = dst;
+
+    fill();
+    gsize = 100;
+    memset(dst, 0x42, gsize);
+    check(dst[0] == 0x42 && dst[99] == 0x42 && dst[100] == 0xEE, "memset global size");
+
+    fill();
+    lsize = 0;
+    memset(dst, 0, lsize);
+    check(dst[0] == 0xEE, "memset zero size");
+
+    fill();
+    lsize = 3;
+    memset(rdst, 0, lsize);
+    check(dst[2] == 0 && dst[3] == 0xEE, "memset register destination");
+}
+
+static void test_memcmp(void)
+{
+    register unsigned char *rsrc = src;
+
+    fill();
+    memcpy(dst, src, sizeof(dst));
+    check(memcmp(dst, src, 200) == 0, "memcmp equal");
+    dst[120] = 0;
+    check(sign(memcmp(dst, src, 200)) == -1, "memcmp less");
+    check(sign(memcmp(src, dst, 200)) == 1, "memcmp greater");
+    check(memcmp(src, dst, 120) == 0, "memcmp prefix");
+
+    gsize = 121;
+    check(sign(memcmp(rsrc, dst, gsize)) == 1, "memcmp variable size");
+    gsize = 120;
+    check(memcmp(rsrc, dst, gsize) == 0, "memcmp variable size equal");
+    gsize = 0;
+    check(memcmp(rsrc, dst, gsize) == 0, "memcmp zero size");
+}
+
+static void test_memchr(void)
+{
+    register unsigned char *rsrc = src;
+
+    fill();
+    check(memchr(src, 50, 200) == src + 49, "memchr found");
+    check(memchr(src, 50, 49) == 0, "memchr not found");
+    check(memchr(rsrc, 1, 1) == src, "memchr register pointer");
+    check(memchr(src + 60, 200, 140) == src + 199, "memchr last byte");
+}
+
+static void test_strchr(void)
+{
+    strcpy(str, "hello, world");
+    check(strchr(str, 'w') == str + 7, "strchr found");
+    check(strchr(str, 'x') == 0, "strchr not found");
+    check(strchr(str, '\0') == str + 12, "strchr terminator");
+    check(strchr(str, 'h') == str, "strchr first");
+}
+
+static void test_strcat(void)
+{
+    str[0] = '\0';
+    strcat(str, "abc");
+    strcat(str, "");
+    strcat(str, "defgh");
+    check(strcmp(str, "abcdefgh") == 0, "strcat");
+    check(strlen(strcat(str, "!")) == 9, "strcat result");
+}
+
+int main(void)
+{
+    test_memcpy();
+    test_memset();
+    test_memcmp();
+    test_memchr();
+    test_strchr();
+    test_strcat();
+
+    if (failures) {
+        printf("%u failures\n", failures);
+    }
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,82 @@
+/*
+** Test the printf family with formats that the compiler precompiles into a
+** descriptor. The test is compiled with all optimization options, so it
+** covers both the descriptors and the plain format strings.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static unsigned char failures;
+
+static char buf[300];
+
+static void check(const char *expected, const char *what)
+{
+    if (strcmp(buf, expected) != 0) {
+        printf("failed: %s: \"%s\" != \"%s\"\n", what, buf, expected);
+        ++failures;
+    }
+}
+
+int main(void)
+{
+    int n = -1234;
+    unsigned u = 65535u;
+    const char *s = "str";
+    int len;
+
+    sprintf(buf, "n=%d u=%u", n, u);
+    check("n=-1234 u=65535", "d and u");
+
+    sprintf(buf, "[%5d][%-5d][%05d][%5u]", 42, 42, 42, 7);
+    check("[   42][42   ][00042][    7]", "width and flags");
+
+    sprintf(buf, "%x %X %04x %c%c", 0xBEEF, 0xBEEF, 0x2A, 'o', 'k');
+    check("beef BEEF 002a ok", "x, X and c");
+
+    sprintf(buf, "%s|%-6s|%6s|", s, s, s);
+    check("str|str   |   str|", "s");
+
+    sprintf(buf, "100%% %d%%", 5);
+    check("100% 5%", "percent");
+
+    sprintf(buf, "%d", -32767 - 1);
+    check("-32768", "minimum int");
+
+    sprintf(buf, "");
+    check("", "empty format");
+
+    sprintf(buf, "no conversion");
+    check("no conversion", "literal only");
+
+    sprintf(buf, "%d\0%d", 1, 2);
+    check("1", "embedded zero");
+
+    /* A literal run longer than fits into one descriptor byte */
+    sprintf(buf, "0123456789012345678901234567890123456789"
+                 "0123456789012345678901234567890123456789"
+                 "0123456789012345678901234567890123456789"
+                 "0123456789012345678901234567890123456789%d", 9);
+    check("0123456789012345678901234567890123456789"
+          "0123456789012345678901234567890123456789"
+          "0123456789012345678901234567890123456789"
+          "01234567890123456789012345678901234567899", "long run");
+
+    len = snprintf(buf, 5, "%s%d", "abcdefgh", 1);
+    check("abcd", "snprintf");
+    if (len != 9) {
+        printf("failed: snprintf returned %d\n", len);
+        ++failures;
+    }
+
+    /* Formats that are not precompiled */
+    sprintf(buf, "%ld %+d %.2s", 70000L, 3, "abc");
+    check("70000 +3 ab", "plain format");
+
+    if (failures) {
+        printf("%u failures\n", failures);
+    }
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
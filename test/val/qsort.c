@@ -0,0 +1,143 @@
+/*
+** Test qsort and the sort functions for unsigned chars and ints with random,
+** presorted, reversed and constant data.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAXCOUNT 300
+
+static unsigned char failures;
+
+static unsigned data[MAXCOUNT];
+static unsigned char bytes[MAXCOUNT];
+
+struct rec {
+    unsigned key;
+    char pad[3];
+};
+static struct rec recs[MAXCOUNT];
+
+static int __fastcall__ cmp_uint(const void *a, const void *b)
+{
+    unsigned x = *(const unsigned *)a;
+    unsigned y = *(const unsigned *)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+static int __fastcall__ cmp_rec(const void *a, const void *b)
+{
+    return cmp_uint(&((const struct rec *)a)->key, &((const struct rec *)b)->key);
+}
+
+static void fill(unsigned count, unsigned char kind)
+{
+    unsigned i;
+
+    srand(count);
+    for (i = 0; i < count; ++i) {
+        switch (kind) {
+            case 0:  data[i] = rand() * 2U;   break;
+            case 1:  data[i] = i;             break;
+            case 2:  data[i] = count - i;     break;
+            case 3:  data[i] = 42;            break;
+            default: data[i] = rand() & 7;    break;
+        }
+        bytes[i] = data[i] >> 3;
+        recs[i].key = data[i];
+        recs[i].pad[0] = (char)i;
+    }
+}
+
+static void check(unsigned count, unsigned char kind, const char *what, int ok)
+{
+    if (!ok) {
+        printf("failed: %s, count %u, kind %u\n", what, count, kind);
+        ++failures;
+    }
+}
+
+static int sorted_uint(const unsigned *p, unsigned count)
+{
+    unsigned i;
+
+    for (i = 1; i < count; ++i) {
+        if (p[i - 1] > p[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int sorted_bytes(unsigned count, unsigned sum)
+{
+    unsigned i;
+
+    for (i = 1; i < count; ++i) {
+        if (bytes[i - 1] > bytes[i]) {
+            return 0;
+        }
+    }
+    for (i = 0; i < count; ++i) {
+        sum -= bytes[i];
+    }
+    return sum == 0;
+}
+
+static int sorted_recs(unsigned count)
+{
+    unsigned i;
+
+    for (i = 1; i < count; ++i) {
+        if (recs[i - 1].key > recs[i].key) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(void)
+{
+    static const unsigned counts[] = { 0, 1, 2, 3, 8, 9, 10, 17, 100, MAXCOUNT };
+    unsigned char c, kind;
+    unsigned count, i, sum;
+
+    for (c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+        count = counts[c];
+        for (kind = 0; kind < 5; ++kind) {
+            fill(count, kind);
+            qsort(data, count, sizeof(data[0]), cmp_uint);
+            check(count, kind, "qsort", sorted_uint(data, count));
+
+            qsort(recs, count, sizeof(recs[0]), cmp_rec);
+            check(count, kind, "qsort records", sorted_recs(count));
+
+            fill(count, kind);
+            __qsort_u16(data, count);
+            check(count, kind, "__qsort_u16", sorted_uint(data, count));
+
+            for (sum = 0, i = 0; i < count; ++i) {
+                sum += bytes[i];
+            }
+            __qsort_u8(bytes, count);
+            check(count, kind, "__qsort_u8", sorted_bytes(count, sum));
+        }
+    }
+
+    /* The sort functions must not touch memory outside of the array */
+    for (i = 0; i < 10; ++i) {
+        data[i] = 10 - i;
+        bytes[i] = 10 - i;
+    }
+    __qsort_u16(data + 1, 8);
+    __qsort_u8(bytes + 1, 8);
+    check(8, 0, "bounds", data[0] == 10 && data[9] == 1 && bytes[0] == 10 &&
+                          bytes[9] == 1 && data[1] == 2 && bytes[8] == 9);
+
+    if (failures) {
+        printf("%u failures\n", failures);
+    }
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
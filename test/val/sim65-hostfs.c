@@ -0,0 +1,114 @@
+/*
+** Test the sim65 paravirtualization functions for stat, directories, time
+** and block reads and writes.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#define SIZE 3000
+
+int fails = 0;
+
+static unsigned char buf[SIZE];
+
+int main (int argc, char **argv)
+{
+    static char outfile_path[FILENAME_MAX+1];
+    static char dir_path[FILENAME_MAX+1];
+    struct stat st;
+    struct dirent *e;
+    DIR *dir;
+    FILE *f;
+    char *name;
+    unsigned i, found;
+
+    sprintf(outfile_path, "%s.test.out", argv[0]);
+
+    /* Write and read back a block */
+    for (i = 0; i < SIZE; ++i) {
+        buf[i] = (unsigned char)(i * 7);
+    }
+    f = fopen(outfile_path, "wb");
+    if (f == NULL || fwrite(buf, 1, SIZE, f) != SIZE) {
+        printf("Could not write %s\n", outfile_path);
+        return 1;
+    }
+    fclose(f);
+    memset(buf, 0, SIZE);
+    f = fopen(outfile_path, "rb");
+    if (f == NULL || fread(buf, 1, SIZE, f) != SIZE) {
+        printf("Could not read %s\n", outfile_path);
+        fails++;
+    }
+    fclose(f);
+    for (i = 0; i < SIZE; ++i) {
+        if (buf[i] != (unsigned char)(i * 7)) {
+            printf("Data mismatch at %u\n", i);
+            fails++;
+            break;
+        }
+    }
+
+    /* stat */
+    if (stat(outfile_path, &st) != 0) {
+        printf("stat() failed\n");
+        fails++;
+    } else if (st.st_size != SIZE || (st.st_mode & S_IREAD) == 0 ||
+               st.st_mtim.tv_sec == 0) {
+        printf("stat() returned wrong data\n");
+        fails++;
+    }
+    if (stat("klsdfjqlsjdflkqjdsoizu", &st) == 0) {
+        printf("stat()ing non-existent file succeeded\n");
+        fails++;
+    }
+
+    /* Find the file in its directory */
+    strcpy(dir_path, outfile_path);
+    name = strrchr(dir_path, '/');
+    if (name == NULL) {
+        name = outfile_path;
+        strcpy(dir_path, ".");
+    } else {
+        *name = '\0';
+        name = outfile_path + (name - dir_path) + 1;
+    }
+    dir = opendir(dir_path);
+    if (dir == NULL) {
+        printf("opendir() failed\n");
+        fails++;
+    } else {
+        found = 0;
+        while ((e = readdir(dir)) != NULL) {
+            if (strcmp(e->d_name, name) == 0) {
+                found = 1;
+                if (e->d_type != 0 && !_DE_ISREG(e->d_type)) {
+                    printf("readdir() returned wrong type\n");
+                    fails++;
+                }
+            }
+        }
+        if (!found) {
+            printf("readdir() didn't find %s\n", name);
+            fails++;
+        }
+        if (closedir(dir) != 0) {
+            printf("closedir() failed\n");
+            fails++;
+        }
+    }
+
+    /* time */
+    if (time(NULL) < 1000000000UL || time(NULL) == (time_t)-1) {
+        printf("time() returned wrong value\n");
+        fails++;
+    }
+
+    remove(outfile_path);
+    return fails;
+}
@@ -0,0 +1,96 @@
+/*
+** Test the sim65 timer peripheral with periodic and one-shot IRQs and NMIs.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <6502.h>
+#include <sim65.h>
+
+static unsigned char irqstack[256];
+static unsigned char ticks;
+static unsigned char nmis;
+
+/* NMI handler: inc nmis, rti */
+static unsigned char nmicode[4] = { 0xEE, 0x00, 0x00, 0x40 };
+
+static unsigned char handler (void)
+{
+    if ((peripherals.timer.status & TIMER_STATUS_EXPIRED) == 0) {
+        return IRQ_NOT_HANDLED;
+    }
+    peripherals.timer.status = 0;
+    ++ticks;
+    return IRQ_HANDLED;
+}
+
+static uint32_t cycles (void)
+{
+    peripherals.counter.select = COUNTER_SELECT_CLOCKCYCLE_COUNTER;
+    peripherals.counter.latch = 0;
+    return peripherals.counter.value32[0];
+}
+
+static uint32_t irqs (void)
+{
+    peripherals.counter.select = COUNTER_SELECT_IRQ_COUNTER;
+    peripherals.counter.latch = 0;
+    return peripherals.counter.value32[0];
+}
+
+int main (void)
+{
+    unsigned char failures = 0;
+    uint32_t start, elapsed, irqstart;
+    unsigned i;
+
+    set_irq (handler, irqstack, sizeof (irqstack));
+
+    /* Periodic IRQ */
+    irqstart = irqs ();
+    start = cycles ();
+    peripherals.timer.period = 2000;
+    peripherals.timer.control = TIMER_CONTROL_ENABLE;
+    while (ticks < 10) {
+    }
+    peripherals.timer.control = 0;
+    elapsed = cycles () - start;
+    if (elapsed < 20000 || elapsed > 22000) {
+        printf ("periodic: %lu cycles for 10 ticks\n", elapsed);
+        ++failures;
+    }
+    if (irqs () - irqstart != 10) {
+        printf ("periodic: %lu IRQs\n", irqs () - irqstart);
+        ++failures;
+    }
+
+    /* One-shot IRQ */
+    ticks = 0;
+    peripherals.timer.period = 500;
+    peripherals.timer.control = TIMER_CONTROL_ENABLE | TIMER_CONTROL_ONESHOT;
+    for (i = 0; i < 1000; ++i) {
+    }
+    if (ticks != 1 || peripherals.timer.control != TIMER_CONTROL_ONESHOT) {
+        printf ("one-shot: %u ticks\n", ticks);
+        ++failures;
+    }
+
+    /* One-shot NMI */
+    *(unsigned*)&nmicode[1] = (unsigned)&nmis;
+    *(unsigned*)0xFFFA = (unsigned)nmicode;
+    ticks = 0;
+    peripherals.timer.period = 300;
+    peripherals.timer.control = TIMER_CONTROL_ENABLE | TIMER_CONTROL_ONESHOT |
+                                TIMER_CONTROL_NMI;
+    for (i = 0; i < 1000; ++i) {
+    }
+    if (nmis != 1 || ticks != 0 ||
+        (peripherals.timer.status & TIMER_STATUS_EXPIRED) == 0) {
+        printf ("NMI: %u NMIs, %u ticks\n", nmis, ticks);
+        ++failures;
+    }
+    peripherals.timer.status = 0;
+
+    reset_irq ();
+    return failures;
+}